@@ -0,0 +1,79 @@
+#include "SyslogKit/LogImporter.hxx"
+#include "SyslogKit/Trace.hxx"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static void usage(const char* argv0) {
+    std::cerr << "Usage: " << argv0 << " [-r] [-j threads] [-t trace.json] <database.db> <logfile>...\n"
+              << "  -r          also import rotated siblings (logfile.1, logfile.2, ...)\n"
+              << "  -j threads  number of parser threads (default: hardware concurrency)\n"
+              << "  -t file     write a Chrome trace of the import (needs a SYSLOGKIT_TRACING build)\n";
+}
+
+int main(int argc, char* argv[]) {
+    bool rotated = false;
+    unsigned threads = 0;
+    std::string tracePath;
+    std::vector<std::string> args;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-r") == 0) {
+            rotated = true;
+        } else if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (std::strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) {
+            usage(argv[0]);
+            return 0;
+        } else {
+            args.emplace_back(argv[i]);
+        }
+    }
+    if (args.size() < 2) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    SYSLOGKIT_TRACE_THREAD("main");
+    SyslogKit::LogStorage storage;
+    if (!storage.open(args[0])) {
+        std::cerr << "Failed to open database: " << args[0] << "\n";
+        return 1;
+    }
+
+    std::vector<std::string> files;
+    for (size_t i = 1; i < args.size(); ++i) {
+        if (rotated) {
+            auto set = SyslogKit::LogImporter::expand_rotated(args[i]);
+            files.insert(files.end(), set.begin(), set.end());
+        } else {
+            files.push_back(args[i]);
+        }
+    }
+
+    SyslogKit::LogImporter importer(storage);
+    if (threads) importer.set_threads(threads);
+    importer.set_progress([](size_t done, size_t total) {
+        if (total) std::cerr << "\r" << (done * 100 / total) << "%" << std::flush;
+    });
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const auto stats = importer.import_files(files);
+    const auto secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::cerr << "\rImported " << stats.rows << " rows from " << stats.files << " file(s), "
+              << (stats.bytes / (1024 * 1024)) << " MiB in " << secs << " s\n";
+    if (!tracePath.empty()) {
+        if (!SYSLOGKIT_TRACING) std::cerr << "Tracing is not compiled in; trace will be empty\n";
+        if (!SyslogKit::Trace::write_chrome_trace(tracePath)) std::cerr << "Failed to write trace: " << tracePath << "\n";
+    }
+    if (stats.failed_files) {
+        std::cerr << stats.failed_files << " file(s) failed\n";
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "SyslogKit/SyslogServer.hxx"
+#include "SyslogKit/LogStorage.hxx"
+#include "SyslogKit/FileSink.hxx"
+#include "SyslogKit/OverloadController.hxx"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+static std::atomic<bool> g_stop{false};
+
+static void on_signal(int) { g_stop = true; }
+
+static void usage(const char* argv0) {
+    std::cerr << "Usage: " << argv0 << " [options]\n"
+              << "  -p port            listen port (default 5140)\n"
+              << "  --no-udp/--no-tcp  disable a protocol\n"
+              << "  --sink MODE        sqlite | file | both (default sqlite)\n"
+              << "  --db PATH          SQLite database (default SyslogKit.db)\n"
+              << "  --file PATH        text archive (default syslogkit.log)\n"
+              << "  --rotate-mb N      rotate the text archive at N MiB (default 256, 0 = off)\n"
+              << "  --rotate-hours N   rotate the text archive every N hours (default off)\n"
+              << "  --keep N           rotated files to keep (default 10)\n"
+              << "  --fsync SECONDS    fsync the text archive at most every SECONDS (default off)\n";
+}
+
+int main(int argc, char* argv[]) {
+    uint16_t port = 5140;
+    bool udp = true, tcp = true;
+    bool useDb = true, useFile = false;
+    std::string dbPath = "SyslogKit.db";
+    SyslogKit::FileSinkOptions fileOpts;
+    fileOpts.path = "syslogkit.log";
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "-p" && hasValue) port = static_cast<uint16_t>(std::stoul(argv[++i]));
+        else if (arg == "--no-udp") udp = false;
+        else if (arg == "--no-tcp") tcp = false;
+        else if (arg == "--db" && hasValue) dbPath = argv[++i];
+        else if (arg == "--file" && hasValue) fileOpts.path = argv[++i];
+        else if (arg == "--rotate-mb" && hasValue) fileOpts.max_bytes = std::stoull(argv[++i]) * 1024 * 1024;
+        else if (arg == "--rotate-hours" && hasValue) fileOpts.max_age = std::chrono::hours(std::stoul(argv[++i]));
+        else if (arg == "--keep" && hasValue) fileOpts.keep = static_cast<unsigned>(std::stoul(argv[++i]));
+        else if (arg == "--fsync" && hasValue) fileOpts.fsync_interval = std::chrono::seconds(std::stoul(argv[++i]));
+        else if (arg == "--sink" && hasValue) {
+            const std::string mode = argv[++i];
+            useDb = mode == "sqlite" || mode == "both";
+            useFile = mode == "file" || mode == "both";
+            if (!useDb && !useFile) { usage(argv[0]); return 1; }
+        } else {
+            usage(argv[0]);
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+    if (!udp && !tcp) {
+        std::cerr << "At least one of UDP/TCP must be enabled\n";
+        return 1;
+    }
+
+    SyslogKit::LogStorage storage;
+    if (useDb && !storage.open(dbPath)) {
+        std::cerr << "Failed to open database: " << dbPath << "\n";
+        return 1;
+    }
+    SyslogKit::FileSink file;
+    if (useFile && !file.open(fileOpts)) {
+        std::cerr << "Failed to open file sink: " << fileOpts.path << "\n";
+        return 1;
+    }
+
+    SyslogKit::OverloadController ingest([&](std::vector<SyslogKit::SyslogMessage>& batch) {
+        if (useDb) storage.write_batch(batch);
+        if (useFile) file.write_batch(batch);
+    });
+    // The file sink only fsyncs on writes; sync the tail of a burst once traffic stops
+    if (useFile) ingest.set_idle([&file] { file.sync(); }, std::chrono::seconds(1));
+    ingest.start();
+
+    SyslogKit::Server server;
+    server.set_callback([&ingest](SyslogKit::SyslogMessage msg) { ingest.offer(std::move(msg)); });
+    server.start(port, udp, tcp);
+
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+    std::cerr << "Listening on port " << port << (udp ? " UDP" : "") << (tcp ? " TCP" : "")
+              << ", sink: " << (useDb ? dbPath : "") << (useDb && useFile ? " + " : "") << (useFile ? fileOpts.path : "") << "\n";
+
+    while (!g_stop) std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    server.stop();
+    ingest.stop();
+    file.close();
+
+    const auto st = ingest.stats();
+    uint64_t accepted = 0;
+    for (const auto v : st.accepted) accepted += v;
+    std::cerr << "Stored " << accepted << " messages, shed " << st.total_shed() << "\n";
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "MainWindow.hpp"
+#include "SyslogKit/Trace.hxx"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QTabWidget>
@@ -20,6 +21,9 @@
 #include <QSpinBox>
 #include <QGroupBox>
 #include <QCheckBox>
+#include <QTimer>
+#include <QPlainTextEdit>
+#include <QStatusBar>
 
 class LogDetailDialog : public QDialog {
 public:
@@ -40,6 +44,9 @@ public:
         addRow("App Name", QString::fromStdString(msg.app_name));
         addRow("Facility", QString::number(static_cast<int>(msg.facility)));
         addRow("Severity", QString::number(static_cast<int>(msg.severity)));
+        if (!msg.structured_data.empty()) {
+            addRow("Structured Data", QString::fromStdString(SyslogKit::SyslogBuilder::format_structured_data(msg.structured_data)));
+        }
 
         lay->addLayout(form);
 
@@ -55,6 +62,34 @@ public:
     }
 };
 
+// "sd:[sd-id.]param=value" tokens become structured-data predicates, the rest (including a plain
+// "status=500") is a message substring
+static SyslogKit::LogFilter parseSearch(const QString& text) {
+    static const QString kSdPrefix = "sd:";
+    SyslogKit::LogFilter filter;
+    QStringList words;
+    for (const auto& token : text.split(' ', Qt::SkipEmptyParts)) {
+        const auto eq = token.indexOf('=');
+        if (!token.startsWith(kSdPrefix) || eq <= kSdPrefix.size()) {
+            words << token;
+            continue;
+        }
+        SyslogKit::SDMatch match;
+        const QString key = token.mid(kSdPrefix.size(), eq - kSdPrefix.size());
+        const auto dot = key.lastIndexOf('.');
+        match.sd_id = dot > 0 ? key.left(dot).toStdString() : std::string();
+        match.param = key.mid(dot + 1).toStdString();
+        match.value = token.mid(eq + 1).remove('"').toStdString();
+        filter.sd_match.push_back(std::move(match));
+    }
+    filter.search_text = words.join(' ').toStdString();
+    return filter;
+}
+
+static QString defaultSinkPath() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/SyslogKit.log";
+}
+
 SyslogModel::SyslogModel(QObject* p) : QAbstractTableModel(p) {}
 
 int SyslogModel::rowCount(const QModelIndex&) const { return static_cast<int>(data_.size()); }
@@ -69,7 +104,7 @@ const SyslogKit::SyslogMessage* SyslogModel::getItem(int row) const {
 
 QVariant SyslogModel::data(const QModelIndex& idx, const int role) const {
     if (idx.row() >= data_.size()) return {};
-    const auto&[facility, severity, timestamp, hostname, app_name, message] = data_[idx.row()];
+    const auto& [facility, severity, timestamp, hostname, app_name, message, sd] = data_[idx.row()];
 
     if (role == Qt::DisplayRole) {
         switch(idx.column()) {
@@ -116,13 +151,42 @@ void SyslogModel::set(const std::vector<SyslogKit::SyslogMessage>& msgs) {
     endResetModel();
 }
 
+void SyslogModel::prepend(const std::vector<SyslogKit::SyslogMessage>& msgs, const int maxRows) {
+    if (msgs.empty()) return;
+    beginInsertRows({}, 0, static_cast<int>(msgs.size()) - 1);
+    data_.insert(data_.begin(), msgs.rbegin(), msgs.rend());
+    endInsertRows();
+
+    if (maxRows > 0 && data_.size() > static_cast<size_t>(maxRows)) {
+        beginRemoveRows({}, maxRows, static_cast<int>(data_.size()) - 1);
+        data_.resize(maxRows);
+        endRemoveRows();
+    }
+}
+
 void SyslogModel::clear() {
     beginResetModel();
     data_.clear();
     endResetModel();
 }
 
-MainWindow::MainWindow() : settings_() {
+MainWindow::MainWindow() : ingest_([this](std::vector<SyslogKit::SyslogMessage>& batch) {
+    const int sinks = sinks_.load(std::memory_order_relaxed);
+    if (sinks & SinkDb) storage_.write_batch(batch);
+    if (sinks & SinkFile) fileSink_.write_batch(batch);
+    SYSLOGKIT_TRACE_SPAN("gui.emit");
+    for (const auto& msg : batch) {
+        emit logReceived(
+            QString::number(static_cast<int>(msg.facility)),
+            QString::number(static_cast<int>(msg.severity)),
+            QString::fromStdString(msg.hostname),
+            QString::fromStdString(msg.app_name),
+            QString::fromStdString(msg.message),
+            QString::fromStdString(msg.timestamp)
+        );
+    }
+}), settings_() {
+    SYSLOGKIT_TRACE_THREAD("gui");
     setupUi();
     const QString dbDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     QDir().mkpath(dbDir);
@@ -134,25 +198,42 @@ MainWindow::MainWindow() : settings_() {
         currentDbLbl_->setText("DB: " + QString::fromStdString(dbPath));
     }
 
+    // Restore the previous session's Live Monitor straight from the mapped ring
+    if (liveRing_.open((dbDir + "/LiveMonitor.ring").toStdString())) {
+        liveModel_->set(liveRing_.load());
+        liveView_->scrollToBottom();
+    }
+
     connect(this, &MainWindow::logReceived, this, &MainWindow::onLogReceived);
+    connect(this, &MainWindow::importFinished, this, &MainWindow::onImportFinished);
+    connect(this, &MainWindow::alertFired, this, &MainWindow::onAlertFired);
 
-    server_.set_callback([this](SyslogKit::SyslogMessage const& msg) {
-        storage_.write(msg);
+    alerts_.set_callback([this](const SyslogKit::Alert& alert) {
+        emit alertFired(QString::fromStdString(alert.rule), QString::fromStdString(alert.group),
+                        alert.count, static_cast<int>(alert.window.count()));
+    });
 
-        emit logReceived(
-            QString::number(static_cast<int>(msg.facility)),
-            QString::number(static_cast<int>(msg.severity)),
-            QString::fromStdString(msg.hostname),
-            QString::fromStdString(msg.app_name),
-            QString::fromStdString(msg.message),
-            QString::fromStdString(msg.timestamp)
-        );
+    // Receive threads only evaluate alerts and enqueue; storage and GUI updates happen on the
+    // ingest writer thread. Alerts see the full stream, including messages shed under overload.
+    server_.set_callback([this](SyslogKit::SyslogMessage msg) {
+        alerts_.process(msg);
+        ingest_.offer(std::move(msg));
     });
+    // The file sink only fsyncs on writes; sync the tail of a burst once traffic stops
+    ingest_.set_idle([this] { fileSink_.sync(); }, std::chrono::seconds(1));
+    ingest_.start();
+
+    auto* statsTimer = new QTimer(this);
+    connect(statsTimer, &QTimer::timeout, this, &MainWindow::onUpdateIngestStats);
+    statsTimer->start(1000);
+
     loadSettings();
 }
 
 MainWindow::~MainWindow() {
+    stopTail();
     server_.stop();
+    ingest_.stop();
 }
 
 void MainWindow::setupUi() {
@@ -180,10 +261,17 @@ void MainWindow::setupUi() {
     statusLbl_->setStyleSheet("color: gray; font-weight: bold;");
 
     auto* btnClear = new QPushButton("Clear View");
-    connect(btnClear, &QPushButton::clicked, [this](){ liveModel_->clear(); });
+    connect(btnClear, &QPushButton::clicked, [this](){
+        liveModel_->clear();
+        liveRing_.clear();
+    });
+
+    shedLbl_ = new QLabel();
+    shedLbl_->setStyleSheet("color: #FFB74D;");
 
     topBar->addWidget(btnStart_);
     topBar->addWidget(statusLbl_);
+    topBar->addWidget(shedLbl_);
     topBar->addStretch();
     topBar->addWidget(btnClear);
 
@@ -206,23 +294,30 @@ void MainWindow::setupUi() {
 
     auto* dbToolsBar = new QHBoxLayout();
 
-    auto* btnSwitchDb = new QPushButton("Open/Switch DB");
-    connect(btnSwitchDb, &QPushButton::clicked, this, &MainWindow::onSwitchDb);
+    btnSwitchDb_ = new QPushButton("Open/Switch DB");
+    connect(btnSwitchDb_, &QPushButton::clicked, this, &MainWindow::onSwitchDb);
     auto* btnExportDb = new QPushButton("Export DB File");
     connect(btnExportDb, &QPushButton::clicked, this, &MainWindow::onExportDb);
+    btnArchives_ = new QPushButton("Open Archives");
+    btnArchives_->setToolTip("Search several .db files at once (read-only)");
+    connect(btnArchives_, &QPushButton::clicked, this, &MainWindow::onOpenArchives);
+    btnImport_ = new QPushButton("Import Log Files");
+    connect(btnImport_, &QPushButton::clicked, this, &MainWindow::onImportLogs);
 
     currentDbLbl_ = new QLabel("DB: <none>");
     currentDbLbl_->setStyleSheet("color: #555; font-size: 10px;");
 
     dbToolsBar->addWidget(new QLabel("Database:"));
-    dbToolsBar->addWidget(btnSwitchDb);
+    dbToolsBar->addWidget(btnSwitchDb_);
     dbToolsBar->addWidget(btnExportDb);
+    dbToolsBar->addWidget(btnArchives_);
+    dbToolsBar->addWidget(btnImport_);
     dbToolsBar->addStretch();
     dbToolsBar->addWidget(currentDbLbl_);
 
     auto* filterBar = new QHBoxLayout();
     searchEdit_ = new QLineEdit();
-    searchEdit_->setPlaceholderText("Search message...");
+    searchEdit_->setPlaceholderText("Search message... (sd:key=value or sd:sd-id.key=value for structured data)");
     connect(searchEdit_, &QLineEdit::returnPressed, this, &MainWindow::onRefreshDb);
 
     limitCombo_ = new QComboBox();
@@ -234,6 +329,14 @@ void MainWindow::setupUi() {
     limitCombo_->setCurrentIndex(1);
     connect(limitCombo_, &QComboBox::currentIndexChanged, this, &MainWindow::onRefreshDb);
 
+    chkTail_ = new QCheckBox("Live");
+    chkTail_->setToolTip("Append newly stored logs matching the current search");
+    connect(chkTail_, &QCheckBox::toggled, this, &MainWindow::onToggleTail);
+
+    chkArchives_ = new QCheckBox("Search archives");
+    chkArchives_->setEnabled(false);
+    connect(chkArchives_, &QCheckBox::toggled, this, &MainWindow::onRefreshDb);
+
     auto* btnSearch = new QPushButton("Refresh / Search");
     connect(btnSearch, &QPushButton::clicked, this, &MainWindow::onRefreshDb);
 
@@ -242,6 +345,8 @@ void MainWindow::setupUi() {
 
     filterBar->addWidget(searchEdit_);
     filterBar->addWidget(limitCombo_);
+    filterBar->addWidget(chkTail_);
+    filterBar->addWidget(chkArchives_);
     filterBar->addWidget(btnSearch);
     filterBar->addWidget(btnExportLogs);
 
@@ -288,6 +393,52 @@ void MainWindow::setupUi() {
     defaultLimitCombo_->addItem("100", 100);
     guiLay->addRow("Default DB View Limit:", defaultLimitCombo_);
 
+    auto* grpSink = new QGroupBox("Storage");
+    auto* sinkLay = new QFormLayout(grpSink);
+    sinkCombo_ = new QComboBox();
+    sinkCombo_->addItem("SQLite database", SinkDb);
+    sinkCombo_->addItem("Text file (rotating)", SinkFile);
+    sinkCombo_->addItem("Both", SinkDb | SinkFile);
+    sinkLay->addRow("Store received logs in:", sinkCombo_);
+
+    auto* pathLay = new QHBoxLayout();
+    sinkPathEdit_ = new QLineEdit();
+    auto* btnBrowse = new QPushButton("...");
+    connect(btnBrowse, &QPushButton::clicked, [this]() {
+        const QString path = QFileDialog::getSaveFileName(this, "Text Log File", sinkPathEdit_->text(), "Log File (*.log);;All Files (*)");
+        if (!path.isEmpty()) sinkPathEdit_->setText(path);
+    });
+    pathLay->addWidget(sinkPathEdit_);
+    pathLay->addWidget(btnBrowse);
+    sinkLay->addRow("Text file:", pathLay);
+
+    rotateMbSpin_ = new QSpinBox();
+    rotateMbSpin_->setRange(0, 1024 * 1024);
+    rotateMbSpin_->setSuffix(" MiB");
+    rotateMbSpin_->setSpecialValueText("Never");
+    sinkLay->addRow("Rotate at:", rotateMbSpin_);
+
+    rotateHoursSpin_ = new QSpinBox();
+    rotateHoursSpin_->setRange(0, 24 * 365);
+    rotateHoursSpin_->setSuffix(" h");
+    rotateHoursSpin_->setSpecialValueText("Never");
+    sinkLay->addRow("Rotate every:", rotateHoursSpin_);
+
+    fsyncSpin_ = new QSpinBox();
+    fsyncSpin_->setRange(0, 3600);
+    fsyncSpin_->setSuffix(" s");
+    fsyncSpin_->setSpecialValueText("Off (OS decides)");
+    sinkLay->addRow("Fsync every:", fsyncSpin_);
+
+    auto* grpAlerts = new QGroupBox("Alert Rules");
+    auto* alertsLay = new QVBoxLayout(grpAlerts);
+    alertsLay->addWidget(new QLabel(
+        "One rule per line: name: match=\"text\" sev<=4 by=host,app,severity window=60 mode=sliding|tumbling threshold=100"));
+    alertRulesEdit_ = new QPlainTextEdit();
+    alertRulesEdit_->setPlaceholderText("auth-failures: match=\"authentication failure\" by=host window=60 threshold=100");
+    alertRulesEdit_->setMaximumHeight(120);
+    alertsLay->addWidget(alertRulesEdit_);
+
     auto* btnLay = new QHBoxLayout();
     auto* btnSaveSet = new QPushButton("Save Settings");
     connect(btnSaveSet, &QPushButton::clicked, this, &MainWindow::onSaveSettings);
@@ -299,14 +450,27 @@ void MainWindow::setupUi() {
     btnLay->addWidget(btnRestore);
     btnLay->addStretch();
 
+    auto* grpDiag = new QGroupBox("Diagnostics");
+    auto* diagLay = new QHBoxLayout(grpDiag);
+    auto* btnTrace = new QPushButton("Save Pipeline Trace...");
+    btnTrace->setEnabled(SYSLOGKIT_TRACING);
+    btnTrace->setToolTip(SYSLOGKIT_TRACING ? "Write recorded spans as Chrome trace-event JSON"
+                                           : "Rebuild with -DSYSLOGKIT_TRACING=ON to record traces");
+    connect(btnTrace, &QPushButton::clicked, this, &MainWindow::onSaveTrace);
+    diagLay->addWidget(btnTrace);
+    diagLay->addStretch();
+
     setLay->addWidget(grpServer);
     setLay->addWidget(grpGui);
+    setLay->addWidget(grpSink);
+    setLay->addWidget(grpAlerts);
+    setLay->addWidget(grpDiag);
     setLay->addLayout(btnLay);
     setLay->addStretch();
 
     tabs_->addTab(setTab, "Settings");
 }
-void MainWindow::loadSettings() const
+void MainWindow::loadSettings()
 {
     const int port = settings_.value("server/port", 5140).toInt();
     portSpin_->setValue(port);
@@ -322,6 +486,51 @@ void MainWindow::loadSettings() const
 
     idx = limitCombo_->findData(defLimit);
     if (idx >= 0) limitCombo_->setCurrentIndex(idx);
+
+    idx = sinkCombo_->findData(settings_.value("sink/mode", static_cast<int>(SinkDb)).toInt());
+    sinkCombo_->setCurrentIndex(idx >= 0 ? idx : 0);
+    sinkPathEdit_->setText(settings_.value("sink/file_path", defaultSinkPath()).toString());
+    rotateMbSpin_->setValue(settings_.value("sink/rotate_mb", 256).toInt());
+    rotateHoursSpin_->setValue(settings_.value("sink/rotate_hours", 0).toInt());
+    fsyncSpin_->setValue(settings_.value("sink/fsync_s", 0).toInt());
+    if (!applySinkSettings()) {
+        QMessageBox::warning(this, "Storage", "Could not open text log file " + sinkPathEdit_->text());
+    }
+
+    const QString rules = settings_.value("alerts/rules").toString();
+    alertRulesEdit_->setPlainText(rules);
+    applyAlertRules(rules);
+}
+
+bool MainWindow::applySinkSettings() {
+    const int mode = sinkCombo_->currentData().toInt();
+    bool ok = true;
+    if (mode & SinkFile) {
+        SyslogKit::FileSinkOptions opts;
+        opts.path = sinkPathEdit_->text().toStdString();
+        opts.max_bytes = static_cast<uint64_t>(rotateMbSpin_->value()) * 1024 * 1024;
+        opts.max_age = std::chrono::hours(rotateHoursSpin_->value());
+        opts.fsync_interval = std::chrono::seconds(fsyncSpin_->value());
+        ok = fileSink_.open(opts);
+    } else {
+        fileSink_.close();
+    }
+    // Never end up storing nothing: fall back to the database if the file can't be opened
+    sinks_.store(ok ? mode : (mode | SinkDb) & ~SinkFile);
+    return ok;
+}
+
+QStringList MainWindow::applyAlertRules(const QString& text) {
+    std::vector<SyslogKit::AlertRule> rules;
+    QStringList invalid;
+    for (const auto& line : text.split('\n', Qt::SkipEmptyParts)) {
+        if (line.trimmed().isEmpty() || line.trimmed().startsWith('#')) continue;
+        SyslogKit::AlertRule rule;
+        if (SyslogKit::AlertRule::parse(line.toStdString(), rule)) rules.push_back(std::move(rule));
+        else invalid << line.trimmed();
+    }
+    alerts_.set_rules(std::move(rules));
+    return invalid;
 }
 
 void MainWindow::onSaveSettings() {
@@ -329,8 +538,22 @@ void MainWindow::onSaveSettings() {
     settings_.setValue("server/udp_enabled", chkUdp_->isChecked());
     settings_.setValue("server/tcp_enabled", chkTcp_->isChecked());
     settings_.setValue("gui/db_limit", defaultLimitCombo_->currentData().toInt());
+    settings_.setValue("alerts/rules", alertRulesEdit_->toPlainText());
+    settings_.setValue("sink/mode", sinkCombo_->currentData().toInt());
+    settings_.setValue("sink/file_path", sinkPathEdit_->text());
+    settings_.setValue("sink/rotate_mb", rotateMbSpin_->value());
+    settings_.setValue("sink/rotate_hours", rotateHoursSpin_->value());
+    settings_.setValue("sink/fsync_s", fsyncSpin_->value());
     settings_.sync();
 
+    if (!applySinkSettings()) {
+        QMessageBox::warning(this, "Storage", "Could not open text log file; logs go to the database.");
+    }
+
+    if (const QStringList invalid = applyAlertRules(alertRulesEdit_->toPlainText()); !invalid.isEmpty()) {
+        QMessageBox::warning(this, "Alert Rules", "Ignored invalid rules:\n" + invalid.join('\n'));
+    }
+
     int idx = limitCombo_->findData(defaultLimitCombo_->currentData().toInt());
     if (idx >= 0) limitCombo_->setCurrentIndex(idx);
 
@@ -379,7 +602,8 @@ void MainWindow::onToggleServer() {
     }
 }
 
-void MainWindow::onLogReceived(const QString &fac, const QString &sev, const QString &host, const QString &app, const QString &msg, const QString &time) const {
+void MainWindow::onLogReceived(const QString &fac, const QString &sev, const QString &host, const QString &app, const QString &msg, const QString &time) {
+    SYSLOGKIT_TRACE_SPAN("gui.apply");
     SyslogKit::SyslogMessage m;
     m.facility = static_cast<SyslogKit::Facility>(fac.toInt());
     m.severity = static_cast<SyslogKit::Severity>(sev.toInt());
@@ -388,15 +612,66 @@ void MainWindow::onLogReceived(const QString &fac, const QString &sev, const QSt
     m.message = msg.toStdString();
     m.timestamp = time.toStdString();
 
+    liveRing_.append(m);
     liveModel_->add(m);
     liveView_->scrollToBottom();
 }
 
+void MainWindow::onUpdateIngestStats() {
+    const auto st = ingest_.stats();
+    const auto shed = st.total_shed();
+    if (shed == 0 && st.level == 0) {
+        shedLbl_->clear();
+        return;
+    }
+
+    static const char* names[] = {"Emerg","Alert","Crit","Error","Warn","Notice","Info","Debug"};
+    QStringList perSev;
+    for (int i = 0; i < 8; ++i) {
+        perSev << QString("%1: %2 kept / %3 shed").arg(names[i]).arg(st.accepted[i]).arg(st.shed[i]);
+    }
+    shedLbl_->setText(QString("Overload level %1, queue %2, shed %3").arg(st.level).arg(st.queue_depth).arg(shed));
+    shedLbl_->setToolTip(perSev.join('\n'));
+}
+
 void MainWindow::onRefreshDb() {
-    SyslogKit::LogFilter filter;
-    filter.search_text = searchEdit_->text().toStdString();
-    const auto logs = storage_.query(filter);
+    stopTail();
+
+    const SyslogKit::LogFilter filter = parseSearch(searchEdit_->text());
+    if (chkArchives_->isChecked()) {
+        // Archives are read-only snapshots: no live tail
+        dbModel_->set(storage_.query_archives(filter));
+        return;
+    }
+
+    int64_t head = 0;
+    const auto logs = storage_.query(filter, &head);
     dbModel_->set(logs);
+
+    if (!chkTail_->isChecked()) return;
+
+    // Batches from a previous subscription may still be queued; drop them by generation
+    const int gen = ++tailGen_;
+    const int maxRows = filter.limit;
+    tailSub_ = storage_.subscribe(filter, head, [this, gen, maxRows](std::vector<SyslogKit::SyslogMessage> rows) {
+        QMetaObject::invokeMethod(this, [this, gen, maxRows, rows = std::move(rows)] {
+            SYSLOGKIT_TRACE_SPAN("gui.tail_apply");
+            if (gen == tailGen_) dbModel_->prepend(rows, maxRows);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void MainWindow::onToggleTail(const bool enabled) {
+    if (enabled) onRefreshDb();
+    else stopTail();
+}
+
+void MainWindow::stopTail() {
+    if (tailSub_) {
+        storage_.unsubscribe(tailSub_);
+        tailSub_ = 0;
+    }
+    ++tailGen_;
 }
 
 void MainWindow::onExportLogs() {
@@ -430,6 +705,76 @@ void MainWindow::onSwitchDb() {
     }
 }
 
+void MainWindow::onOpenArchives() {
+    const QStringList paths = QFileDialog::getOpenFileNames(this, "Open Archives", "", "SQLite DB (*.db *.sqlite);;All Files (*)");
+    if (paths.isEmpty()) return;
+
+    std::vector<std::string> files;
+    for (const auto& p : paths) files.push_back(p.toStdString());
+
+    if (storage_.open_archives(files)) {
+        chkArchives_->setEnabled(true);
+        chkArchives_->setText(QString("Search archives (%1)").arg(files.size()));
+        if (chkArchives_->isChecked()) onRefreshDb();
+        else chkArchives_->setChecked(true);
+    } else {
+        chkArchives_->setChecked(false);
+        chkArchives_->setEnabled(false);
+        chkArchives_->setText("Search archives");
+        QMessageBox::critical(this, "Error", "Failed to open one or more archive files.");
+    }
+}
+
+void MainWindow::onImportLogs() {
+    if (!storage_.is_open()) {
+        QMessageBox::warning(this, "Warning", "No database is currently open.");
+        return;
+    }
+
+    const QStringList paths = QFileDialog::getOpenFileNames(this, "Import Log Files", "", "Log Files (*.log *.log.* syslog*);;All Files (*)");
+    if (paths.isEmpty()) return;
+
+    const bool rotated = QMessageBox::question(this, "Import",
+        "Also import rotated files (name.1, name.2, ...) next to the selected ones?") == QMessageBox::Yes;
+
+    std::vector<std::string> files;
+    for (const auto& p : paths) {
+        if (rotated) {
+            auto set = SyslogKit::LogImporter::expand_rotated(p.toStdString());
+            files.insert(files.end(), set.begin(), set.end());
+        } else {
+            files.push_back(p.toStdString());
+        }
+    }
+
+    // The importer writes through storage_: switching databases mid-import would split the rows
+    // across two files and leave the first one with its indexes dropped
+    btnImport_->setEnabled(false);
+    btnImport_->setText("Importing...");
+    btnSwitchDb_->setEnabled(false);
+    btnArchives_->setEnabled(false);
+    importThread_ = std::jthread([this, files = std::move(files)] {
+        SyslogKit::LogImporter importer(storage_);
+        const auto stats = importer.import_files(files);
+        emit importFinished(stats.rows, stats.files, stats.failed_files);
+    });
+}
+
+void MainWindow::onImportFinished(const qulonglong rows, const qulonglong files, const qulonglong failed) {
+    btnImport_->setEnabled(true);
+    btnImport_->setText("Import Log Files");
+    btnSwitchDb_->setEnabled(true);
+    btnArchives_->setEnabled(true);
+    onRefreshDb();
+
+    const QString text = QString("Imported %1 rows from %2 file(s).").arg(rows).arg(files);
+    if (failed) {
+        QMessageBox::warning(this, "Import", text + QString("\n%1 file(s) could not be read.").arg(failed));
+    } else {
+        QMessageBox::information(this, "Import", text);
+    }
+}
+
 void MainWindow::onExportDb() {
     if (!storage_.is_open()) {
         QMessageBox::warning(this, "Warning", "No database is currently open.");
@@ -464,12 +809,36 @@ void MainWindow::showDetailDialog(const SyslogKit::SyslogMessage& msg) {
     dlg.exec();
 }
 
+void MainWindow::onAlertFired(const QString& rule, const QString& group, const qulonglong count, const int windowSecs) {
+    QString text = QString("ALERT %1: %2 messages in %3 s").arg(rule).arg(count).arg(windowSecs);
+    if (!group.isEmpty()) text += " (" + group + ")";
+    statusBar()->setStyleSheet("color: #FF5252; font-weight: bold;");
+    statusBar()->showMessage(QDateTime::currentDateTime().toString("HH:mm:ss ") + text, 30000);
+    QApplication::alert(this);
+}
+
+void MainWindow::onSaveTrace() {
+    const QString path = QFileDialog::getSaveFileName(this, "Save Trace", "syslogkit-trace.json", "Chrome Trace (*.json)");
+    if (path.isEmpty()) return;
+
+    if (SyslogKit::Trace::write_chrome_trace(path.toStdString())) {
+        QMessageBox::information(this, "Trace", "Trace saved. Open it in chrome://tracing or ui.perfetto.dev.");
+    } else {
+        QMessageBox::warning(this, "Error", "Could not write trace file.");
+    }
+}
+
 void MainWindow::onRestoreDefaults() {
     if (QMessageBox::question(this, "Confirm", "Reset all settings to default values?") == QMessageBox::Yes) {
         portSpin_->setValue(5140);
         chkUdp_->setChecked(true);
         chkTcp_->setChecked(true);
         defaultLimitCombo_->setCurrentIndex(1);
+        sinkCombo_->setCurrentIndex(0);
+        sinkPathEdit_->setText(defaultSinkPath());
+        rotateMbSpin_->setValue(256);
+        rotateHoursSpin_->setValue(0);
+        fsyncSpin_->setValue(0);
 
         onSaveSettings();
     }
@@ -6,6 +6,13 @@
 #include <vector>
 #include "SyslogKit/SyslogServer.hxx"
 #include "SyslogKit/LogStorage.hxx"
+#include "SyslogKit/LogImporter.hxx"
+#include "SyslogKit/OverloadController.hxx"
+#include "SyslogKit/AlertEngine.hxx"
+#include "SyslogKit/RingFile.hxx"
+#include "SyslogKit/FileSink.hxx"
+#include <atomic>
+#include <thread>
 
 class QTableView;
 class QLabel;
@@ -15,6 +22,7 @@ class QTabWidget;
 class QComboBox;
 class QSpinBox;
 class QCheckBox;
+class QPlainTextEdit;
 
 class SyslogModel : public QAbstractTableModel {
     Q_OBJECT
@@ -27,6 +35,8 @@ public:
 
     void add(const SyslogKit::SyslogMessage& msg);
     void set(const std::vector<SyslogKit::SyslogMessage>& msgs);
+    // Inserts rows (oldest first) at the top, keeping at most maxRows (0 = unlimited)
+    void prepend(const std::vector<SyslogKit::SyslogMessage>& msgs, int maxRows);
     void clear();
     [[nodiscard]] const std::vector<SyslogKit::SyslogMessage>& items() const { return data_; }
     [[nodiscard]] const SyslogKit::SyslogMessage* getItem(int row) const;
@@ -43,25 +53,43 @@ public:
 
     signals:
         void logReceived(QString fac, QString sev, QString host, QString app, QString msg, QString time);
+        void importFinished(qulonglong rows, qulonglong files, qulonglong failed);
+        void alertFired(QString rule, QString group, qulonglong count, int windowSecs);
 
 private slots:
     void onToggleServer();
-    void onLogReceived(const QString &fac, const QString &sev, const QString &host, const QString &app, const QString &msg, const QString &time) const;
+    void onLogReceived(const QString &fac, const QString &sev, const QString &host, const QString &app, const QString &msg, const QString &time);
     void onRefreshDb();
     void onExportLogs();    // Экспорт в .log (текст)
     void onExportDb();      // Экспорт .db файла
     void onSwitchDb();      // Сменить текущий .db (Import)
+    void onImportLogs();    // Импорт текстовых syslog файлов
+    void onOpenArchives();  // Поиск по нескольким .db (только чтение)
+    void onImportFinished(qulonglong rows, qulonglong files, qulonglong failed);
+    void onToggleTail(bool enabled);
+    void onUpdateIngestStats();
+    void onSaveTrace();
+    void onAlertFired(const QString& rule, const QString& group, qulonglong count, int windowSecs);
     void onTabChanged(int index);
     void onTableDoubleClicked(const QModelIndex &index);
     void onSaveSettings();
     void onRestoreDefaults();
 private:
     void setupUi();
-    void loadSettings() const;
+    void loadSettings();
     void showDetailDialog(const SyslogKit::SyslogMessage& msg);
+    void stopTail();
+    QStringList applyAlertRules(const QString& text);
+    bool applySinkSettings();
 
     SyslogKit::Server server_;
     SyslogKit::LogStorage storage_;
+    SyslogKit::FileSink fileSink_;
+    enum SinkFlags { SinkDb = 1, SinkFile = 2 };
+    std::atomic<int> sinks_{SinkDb};
+    SyslogKit::OverloadController ingest_;
+    SyslogKit::AlertEngine alerts_;
+    SyslogKit::RingFile liveRing_; // warm-start copy of the Live Monitor
     QSettings settings_;
     bool isRunning_ = false;
 
@@ -73,13 +101,29 @@ private:
 
     QPushButton* btnStart_{};
     QLabel* statusLbl_{};
+    QLabel* shedLbl_{};
 
     QLineEdit* searchEdit_{};
     QComboBox* limitCombo_{};
+    QCheckBox* chkTail_{};
+    QCheckBox* chkArchives_{};
+    int tailSub_ = 0;
+    int tailGen_ = 0;
     QLabel* currentDbLbl_{};
+    QPushButton* btnImport_{};
+    QPushButton* btnSwitchDb_{};
+    QPushButton* btnArchives_{};
 
     QSpinBox* portSpin_{};
     QCheckBox* chkUdp_{};
     QCheckBox* chkTcp_{};
     QComboBox* defaultLimitCombo_{};
+    QPlainTextEdit* alertRulesEdit_{};
+    QComboBox* sinkCombo_{};
+    QLineEdit* sinkPathEdit_{};
+    QSpinBox* rotateMbSpin_{};
+    QSpinBox* rotateHoursSpin_{};
+    QSpinBox* fsyncSpin_{};
+
+    std::jthread importThread_;
 };
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+#include "SyslogProto.hxx"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace SyslogKit {
+
+    struct AlertRule {
+        enum class Window { Sliding, Tumbling };
+
+        std::string name;
+        std::string match_text;          // substring of the message; empty matches everything
+        int max_severity = 7;            // only messages at least this severe (sev <= max_severity)
+        bool by_host = false;            // group keys
+        bool by_app = false;
+        bool by_severity = false;
+        Window window = Window::Sliding;
+        std::chrono::seconds length{60};
+        uint32_t buckets = 12;           // sliding-window resolution; tumbling windows use one bucket
+        uint64_t threshold = 100;        // fires when the windowed count exceeds this
+
+        // "name: match=\"auth failure\" sev<=4 by=host,app window=60 mode=sliding threshold=100 buckets=12"
+        static bool parse(std::string_view line, AlertRule& out);
+    };
+
+    struct Alert {
+        std::string rule;
+        std::string group;               // "host=..,app=..,sev=.." for grouped rules, empty otherwise
+        uint64_t count = 0;
+        std::chrono::seconds window{0};
+    };
+
+    // Continuous rule evaluation on the message stream. Each (rule, group) keeps a ring of
+    // time buckets and a running total, so a message costs O(1) per rule; a group fires at most
+    // once per window length.
+    class AlertEngine {
+    public:
+        using Callback = std::function<void(const Alert&)>;
+        using Clock = std::chrono::steady_clock;
+
+        void set_callback(Callback cb);
+        void set_rules(std::vector<AlertRule> rules);
+        [[nodiscard]] std::vector<AlertRule> rules() const;
+
+        // Thread-safe; the callback runs on the calling thread after the engine lock is released
+        void process(const SyslogMessage& msg) { process(msg, Clock::now()); }
+        void process(const SyslogMessage& msg, Clock::time_point now);
+
+    private:
+        struct Counter {
+            std::vector<uint32_t> buckets;
+            int64_t head = -1;           // absolute index of the newest bucket
+            uint64_t total = 0;
+            int64_t fired_at = -1;       // absolute bucket index of the last alert
+        };
+
+        struct RuleState {
+            AlertRule rule;
+            Clock::duration bucket_width{};
+            std::unordered_map<std::string, Counter> groups;
+        };
+
+        static std::string group_key(const AlertRule& rule, const SyslogMessage& msg);
+        void evict_idle(Clock::duration now);
+
+        mutable std::mutex mutex_;
+        std::vector<RuleState> states_;
+        Callback callback_;
+        uint64_t processed_ = 0;
+    };
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "SyslogProto.hxx"
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace SyslogKit {
+
+    struct FileSinkOptions {
+        std::string path;
+        uint64_t max_bytes = 256ull * 1024 * 1024;      // rotate at this size; 0 = never
+        std::chrono::seconds max_age{0};                // rotate after this long; 0 = never
+        std::chrono::seconds fsync_interval{0};         // periodic fsync; 0 = leave it to the OS
+        unsigned keep = 10;                             // rotated files kept: path.1 .. path.N
+    };
+
+    // Append-only text sink. Messages are formatted with SyslogBuilder::build_to into a set of
+    // reusable buffers and each batch goes out with a single writev(). Rotated files follow the
+    // logrotate naming (path.1 is the newest), which LogImporter::expand_rotated() reads back.
+    class FileSink {
+    public:
+        FileSink();
+        ~FileSink();
+
+        FileSink(const FileSink&) = delete;
+        FileSink& operator=(const FileSink&) = delete;
+
+        bool open(const FileSinkOptions& options);
+        void close();
+        bool write_batch(const std::vector<SyslogMessage>& msgs);
+        bool write(const SyslogMessage& msg) { return write_batch({msg}); }
+        // Syncs data written since the last fsync (no-op when fsync_interval is 0). write_batch() only
+        // syncs once the interval has passed, so call this when traffic stops to bound the loss window.
+        void sync();
+
+        [[nodiscard]] bool is_open();
+
+    private:
+        bool open_locked();
+        void close_locked();
+        bool rotate_locked();
+        bool flush_locked();
+        void sync_locked();
+
+        static constexpr size_t kBufferSize = 256 * 1024;
+
+        std::mutex mutex_;
+        FileSinkOptions options_;
+        int fd_ = -1;
+        uint64_t file_bytes_ = 0;
+        std::chrono::system_clock::time_point created_at_{}; // max_age is measured from here
+        std::chrono::steady_clock::time_point synced_at_{};
+        bool unsynced_ = false;
+        std::vector<std::string> buffers_; // capacity is kept between batches
+        size_t used_ = 0;                  // buffers_[0, used_) hold pending data
+    };
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "LogStorage.hxx"
+#include <functional>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace SyslogKit {
+
+    struct ImportStats {
+        size_t files = 0;
+        size_t bytes = 0;
+        size_t rows = 0;
+        size_t failed_files = 0;
+    };
+
+    // Bulk import of plain-text syslog files (one message per line).
+    // Files are memory-mapped, split into line-aligned chunks and parsed in parallel;
+    // parsed chunks are written in file order, one transaction per chunk.
+    class LogImporter {
+    public:
+        using Progress = std::function<void(size_t bytes_done, size_t bytes_total)>;
+
+        explicit LogImporter(LogStorage& storage);
+
+        void set_threads(unsigned threads) { threads_ = threads ? threads : 1; }
+        void set_chunk_size(size_t bytes) { chunk_size_ = bytes ? bytes : 1; }
+        void set_progress(Progress cb) { progress_ = std::move(cb); }
+
+        ImportStats import_files(const std::vector<std::string>& paths);
+
+        // "syslog" -> {"syslog.N", ..., "syslog.1", "syslog"}, oldest first; compressed rotations are skipped
+        static std::vector<std::string> expand_rotated(const std::string& path);
+
+    private:
+        bool import_file(const std::string& path, size_t bytes_total, ImportStats& stats);
+
+        LogStorage& storage_;
+        unsigned threads_;
+        size_t chunk_size_ = 8 * 1024 * 1024;
+        Progress progress_;
+    };
+}
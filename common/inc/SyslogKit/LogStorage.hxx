@@ -2,33 +2,101 @@
 #include "SyslogProto.hxx"
 #include <vector>
 #include <string>
+#include <mutex>
+#include <memory>
+#include <functional>
+#include <cstdint>
+#include <span>
+#include <thread>
 
 struct sqlite3;
 
 namespace SyslogKit {
 
+    // Structured-data predicate: param="value", optionally restricted to one SD-ID
+    struct SDMatch {
+        std::string sd_id;
+        std::string param;
+        std::string value;
+    };
+
     struct LogFilter {
         std::string search_text;
         int min_severity = -1;
         int limit = 50;
+        std::vector<SDMatch> sd_match; // all must hold (AND)
     };
 
     class LogStorage {
     public:
+        // Receives rows committed after the subscriber's last seen id, oldest first.
+        // Invoked on the writing thread, after the commit and outside the storage lock; must not write.
+        using TailCallback = std::function<void(std::vector<SyslogMessage>)>;
+
         LogStorage();
         ~LogStorage();
 
         bool open(const std::string& path);
         void close();
         bool write(const SyslogMessage& msg);
-        std::vector<SyslogMessage> query(const LogFilter& filter);
+        // Inserts all messages inside a single transaction with one prepared statement
+        bool write_batch(const std::vector<SyslogMessage>& msgs);
+        // Newest rows first; head_id (if given) receives the current max row id, read under the same lock
+        std::vector<SyslogMessage> query(const LogFilter& filter, int64_t* head_id = nullptr);
+        // Matching rows with id > last_id, oldest first, at most filter.limit of the newest;
+        // advances last_id to the current head
+        std::vector<SyslogMessage> query_since(const LogFilter& filter, int64_t& last_id);
+        [[nodiscard]] int64_t head_id();
+
+        // Live tail: cb is driven by commits from write()/write_batch(), not by polling
+        int subscribe(const LogFilter& filter, int64_t last_id, TailCallback cb);
+        void unsubscribe(int id);
+
+        // Read-only archive set, independent of the database opened with open().
+        // query_archives() runs the filter on every archive in parallel (one worker per file) and
+        // merges the per-file results newest-first by ts_sort (the parsed timestamp), stopping at filter.limit.
+        bool open_archives(const std::vector<std::string>& paths);
+        void close_archives();
+        std::vector<SyslogMessage> query_archives(const LogFilter& filter);
+        [[nodiscard]] std::vector<std::string> archive_paths();
+
+        // Bulk loading: drop the timestamp indexes before a large import and rebuild them once afterwards
+        void drop_indexes();
+        void create_indexes();
 
         [[nodiscard]] std::string get_db_path() const { return db_path_; }
         [[nodiscard]] bool is_open() const { return db_ != nullptr; }
 
     private:
+        struct Subscription {
+            int id = 0;
+            LogFilter filter;
+            int64_t last_id = 0;
+            TailCallback callback;
+            std::mutex mutex;
+        };
+
         void init_table();
+        void create_indexes_locked();
+        void stop_backfill();
+        void backfill_sort_keys(std::stop_token stop);
+        void close_locked();
+        bool insert_locked(std::span<const SyslogMessage> msgs);
+        [[nodiscard]] int64_t head_id_locked() const;
+        void notify_subscribers();
+
         sqlite3* db_ = nullptr;
         std::string db_path_;
+        std::mutex mutex_;
+        int64_t backfill_end_ = 0; // rows with id <= this may still lack ts_sort
+        std::jthread backfill_;
+
+        std::mutex archives_mutex_;
+        std::vector<sqlite3*> archives_;
+        std::vector<std::string> archive_paths_;
+
+        std::mutex subs_mutex_;
+        std::vector<std::shared_ptr<Subscription>> subs_;
+        int next_sub_id_ = 1;
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "SyslogProto.hxx"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SyslogKit {
+
+    struct OverloadStats {
+        std::array<uint64_t, 8> accepted{}; // per severity
+        std::array<uint64_t, 8> shed{};     // per severity
+        size_t queue_depth = 0;
+        int level = 0;                      // 0 = normal .. 3 = heaviest sampling
+        double write_us_per_msg = 0.0;      // smoothed sink latency
+
+        [[nodiscard]] uint64_t total_shed() const {
+            uint64_t n = 0;
+            for (const auto v : shed) n += v;
+            return n;
+        }
+    };
+
+    // Bounded hand-off between the receive threads and the sinks. Messages are queued by offer()
+    // and drained in batches on a dedicated writer thread. As the queue fills up or the time to drain
+    // it at the measured sink speed grows, low-priority severities are sampled and then dropped:
+    //   level 1: Debug 1/10
+    //   level 2: Debug 1/100, Info/Notice 1/10
+    //   level 3: Debug dropped, Info/Notice 1/100
+    // Warning and above use a reserve of 2x capacity. Once that is full they evict a queued lower-severity
+    // message (Debug first, newest first) and are only shed when the queue holds nothing else.
+    class OverloadController {
+    public:
+        using Sink = std::function<void(std::vector<SyslogMessage>& batch)>;
+        using Idle = std::function<void()>;
+
+        explicit OverloadController(Sink sink);
+        ~OverloadController();
+
+        void start();
+        void stop(); // drains what is queued, then joins the writer
+
+        void set_capacity(size_t capacity) { capacity_ = capacity ? capacity : 1; }
+        void set_batch_size(size_t batch) { batch_size_ = batch ? batch : 1; }
+        // Backlog (in time to write it out) treated as full pressure
+        void set_max_drain(std::chrono::milliseconds drain) { max_drain_us_ = std::max(1.0, static_cast<double>(drain.count()) * 1000.0); }
+        // Called on the writer thread whenever nothing arrived for `after` (e.g. to fsync sinks); set before start()
+        void set_idle(Idle idle, std::chrono::milliseconds after) { idle_ = std::move(idle); idle_after_ = after; }
+
+        // Thread-safe; returns false if the message was shed
+        bool offer(SyslogMessage msg);
+
+        [[nodiscard]] OverloadStats stats() const;
+
+    private:
+        void writer_loop();
+        [[nodiscard]] int compute_level(size_t depth) const;
+        bool admit(Severity sev, int level, size_t depth);
+        bool evict_low_locked();
+        [[nodiscard]] size_t depth_locked() const;
+
+        struct Queued {
+            uint64_t seq; // arrival order across the per-class queues
+            SyslogMessage msg;
+        };
+
+        Sink sink_;
+        Idle idle_;
+        std::chrono::milliseconds idle_after_{1000};
+        size_t capacity_ = 50000;
+        size_t batch_size_ = 1024;
+        double max_drain_us_ = 500000.0;
+
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        std::array<std::deque<Queued>, 4> queues_; // Warning and above, Notice, Info, Debug
+        uint64_t next_seq_ = 0;
+        bool running_ = false;
+        std::jthread writer_;
+
+        std::atomic<double> write_us_per_msg_{0.0};
+        std::array<std::atomic<uint64_t>, 8> accepted_{};
+        std::array<std::atomic<uint64_t>, 8> shed_{};
+        std::array<std::atomic<uint64_t>, 8> sample_seq_{};
+    };
+}
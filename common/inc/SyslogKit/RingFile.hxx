@@ -0,0 +1,47 @@
+#pragma once
+#include "SyslogProto.hxx"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SyslogKit {
+
+    // Fixed-size, memory-mapped ring of recent messages. Records are stored in fixed slots in a
+    // binary layout, so reloading is a copy out of the mapping with no parsing or SQL.
+    // Each slot carries its sequence number and a checksum: after a crash, torn or stale slots are
+    // skipped and the write position is recovered from the newest valid slot.
+    class RingFile {
+    public:
+        RingFile();
+        ~RingFile();
+
+        RingFile(const RingFile&) = delete;
+        RingFile& operator=(const RingFile&) = delete;
+
+        // Maps an existing ring with the same geometry, or (re)creates the file
+        bool open(const std::string& path, uint32_t slot_count = 5000, uint32_t slot_size = 1024);
+        void close();
+
+        void append(const SyslogMessage& msg); // long fields are truncated to fit a slot
+        void clear();
+        [[nodiscard]] std::vector<SyslogMessage> load() const; // oldest first
+
+        [[nodiscard]] bool is_open() const { return base_ != nullptr; }
+
+    private:
+        bool map(const std::string& path, size_t size, bool& created);
+        void recover();
+
+        unsigned char* base_ = nullptr;
+        size_t size_ = 0;
+        uint32_t slot_count_ = 0;
+        uint32_t slot_size_ = 0;
+        uint64_t next_seq_ = 1;
+    #ifdef _WIN32
+        void* file_ = nullptr;
+        void* mapping_ = nullptr;
+    #else
+        int fd_ = -1;
+    #endif
+    };
+}
@@ -3,6 +3,7 @@
 #include <string>
 #include <string_view>
 #include <cstdint>
+#include <vector>
 
 namespace SyslogKit {
 
@@ -25,6 +26,18 @@ namespace SyslogKit {
         Local6 = 22, Local7 = 23
     };
 
+    // RFC 5424 SD-PARAM: name="value"
+    struct SDParam {
+        std::string name;
+        std::string value;
+    };
+
+    // RFC 5424 SD-ELEMENT: [sd-id name="value" ...]
+    struct SDElement {
+        std::string id;
+        std::vector<SDParam> params;
+    };
+
     struct SyslogMessage {
         Facility facility = Facility::User;
         Severity severity = Severity::Info;
@@ -32,6 +45,7 @@ namespace SyslogKit {
         std::string hostname;
         std::string app_name;
         std::string message;
+        std::vector<SDElement> structured_data;
 
         [[nodiscard]] int get_priority() const {
             return (static_cast<int>(facility) * 8) + static_cast<int>(severity);
@@ -41,8 +55,18 @@ namespace SyslogKit {
     class SyslogBuilder {
     public:
         static std::string build(const SyslogMessage& msg);
+        // Appends the built message to out, reusing its capacity
+        static void build_to(const SyslogMessage& msg, std::string& out);
 
         static SyslogMessage parse(std::string_view raw_msg);
+
+        // Parses consecutive SD-ELEMENTs at the start of text; returns the number of bytes consumed (0 if none)
+        static size_t parse_structured_data(std::string_view text, std::vector<SDElement>& out);
+        static std::string format_structured_data(const std::vector<SDElement>& sd);
+
+        // Sortable form of an RFC 3339 or RFC 3164 timestamp, in ms since the epoch. RFC 3164 stamps
+        // are local time with the year inferred relative to now_ms; unrecognised text yields now_ms.
+        static int64_t timestamp_to_epoch_ms(std::string_view ts, int64_t now_ms);
     };
 
 } // namespace syslog
\ No newline at end of file
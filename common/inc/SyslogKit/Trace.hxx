@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Build with -DSYSLOGKIT_TRACING=ON to record pipeline spans; otherwise the macros compile to nothing
+#ifndef SYSLOGKIT_TRACING
+#define SYSLOGKIT_TRACING 0
+#endif
+
+namespace SyslogKit {
+
+    // Span recorder. Each thread appends to its own fixed-size ring (single writer, no locks on the
+    // hot path); dump() snapshots all rings and writes Chrome trace-event JSON (chrome://tracing, Perfetto).
+    class Trace {
+    public:
+        static uint64_t now_ns();
+        static void record(const char* name, uint64_t start_ns, uint64_t end_ns);
+        static void set_thread_name(const char* name);
+
+        static bool write_chrome_trace(const std::string& path);
+        static std::string chrome_trace_json();
+    };
+
+    class TraceSpan {
+    public:
+        explicit TraceSpan(const char* name) : name_(name), start_(Trace::now_ns()) {}
+        ~TraceSpan() { Trace::record(name_, start_, Trace::now_ns()); }
+
+        TraceSpan(const TraceSpan&) = delete;
+        TraceSpan& operator=(const TraceSpan&) = delete;
+
+    private:
+        const char* name_; // must be a string literal
+        uint64_t start_;
+    };
+}
+
+#if SYSLOGKIT_TRACING
+    #define SYSLOGKIT_TRACE_CONCAT_(a, b) a##b
+    #define SYSLOGKIT_TRACE_CONCAT(a, b) SYSLOGKIT_TRACE_CONCAT_(a, b)
+    #define SYSLOGKIT_TRACE_SPAN(name) const ::SyslogKit::TraceSpan SYSLOGKIT_TRACE_CONCAT(trace_span_, __LINE__)(name)
+    #define SYSLOGKIT_TRACE_THREAD(name) ::SyslogKit::Trace::set_thread_name(name)
+#else
+    #define SYSLOGKIT_TRACE_SPAN(name) ((void)0)
+    #define SYSLOGKIT_TRACE_THREAD(name) ((void)0)
+#endif
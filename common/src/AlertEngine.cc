@@ -0,0 +1,182 @@
+#include "SyslogKit/AlertEngine.hxx"
+#include <algorithm>
+#include <charconv>
+
+namespace SyslogKit {
+
+    static std::string_view trim(std::string_view s) {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+        return s;
+    }
+
+    template <typename T>
+    static bool parse_number(std::string_view s, T& out) {
+        const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+        return ec == std::errc() && ptr == s.data() + s.size();
+    }
+
+    bool AlertRule::parse(std::string_view line, AlertRule& out) {
+        line = trim(line);
+        const auto colon = line.find(':');
+        if (line.empty() || line.front() == '#' || colon == std::string_view::npos) return false;
+
+        AlertRule rule;
+        rule.name = std::string(trim(line.substr(0, colon)));
+        if (rule.name.empty()) return false;
+
+        auto rest = line.substr(colon + 1);
+        while (true) {
+            rest = trim(rest);
+            if (rest.empty()) break;
+
+            // key=value, key<=value; values may be double-quoted
+            const auto op = rest.find_first_of("=<");
+            if (op == std::string_view::npos) return false;
+            const auto key = rest.substr(0, op);
+            const size_t value_start = rest.substr(op).starts_with("<=") ? op + 2 : op + 1;
+
+            std::string_view value;
+            if (value_start < rest.size() && rest[value_start] == '"') {
+                const auto close = rest.find('"', value_start + 1);
+                if (close == std::string_view::npos) return false;
+                value = rest.substr(value_start + 1, close - value_start - 1);
+                rest.remove_prefix(close + 1);
+            } else {
+                const auto end = std::min(rest.find(' ', value_start), rest.size());
+                value = rest.substr(value_start, end - value_start);
+                rest.remove_prefix(end);
+            }
+
+            if (key == "match") {
+                rule.match_text = std::string(value);
+            } else if (key == "sev") {
+                if (!parse_number(value, rule.max_severity)) return false;
+            } else if (key == "by") {
+                while (!value.empty()) {
+                    const auto comma = std::min(value.find(','), value.size());
+                    const auto field = value.substr(0, comma);
+                    if (field == "host") rule.by_host = true;
+                    else if (field == "app") rule.by_app = true;
+                    else if (field == "severity" || field == "sev") rule.by_severity = true;
+                    else return false;
+                    value.remove_prefix(std::min(comma + 1, value.size()));
+                }
+            } else if (key == "window") {
+                int64_t secs = 0;
+                if (!parse_number(value, secs) || secs <= 0) return false;
+                rule.length = std::chrono::seconds(secs);
+            } else if (key == "mode") {
+                if (value == "sliding") rule.window = Window::Sliding;
+                else if (value == "tumbling") rule.window = Window::Tumbling;
+                else return false;
+            } else if (key == "threshold") {
+                if (!parse_number(value, rule.threshold)) return false;
+            } else if (key == "buckets") {
+                if (!parse_number(value, rule.buckets) || rule.buckets == 0) return false;
+            } else {
+                return false;
+            }
+        }
+
+        out = std::move(rule);
+        return true;
+    }
+
+    void AlertEngine::set_callback(Callback cb) {
+        std::lock_guard lock(mutex_);
+        callback_ = std::move(cb);
+    }
+
+    void AlertEngine::set_rules(std::vector<AlertRule> rules) {
+        std::lock_guard lock(mutex_);
+        states_.clear();
+        for (auto& rule : rules) {
+            RuleState st;
+            if (rule.window == AlertRule::Window::Tumbling) rule.buckets = 1;
+            st.bucket_width = std::max<Clock::duration>(
+                std::chrono::duration_cast<Clock::duration>(rule.length) / rule.buckets, Clock::duration(1));
+            st.rule = std::move(rule);
+            states_.push_back(std::move(st));
+        }
+    }
+
+    std::vector<AlertRule> AlertEngine::rules() const {
+        std::lock_guard lock(mutex_);
+        std::vector<AlertRule> res;
+        for (const auto& st : states_) res.push_back(st.rule);
+        return res;
+    }
+
+    std::string AlertEngine::group_key(const AlertRule& rule, const SyslogMessage& msg) {
+        std::string key;
+        auto add = [&key](const char* name, const std::string& value) {
+            if (!key.empty()) key += ',';
+            key += name;
+            key += '=';
+            key += value;
+        };
+        if (rule.by_host) add("host", msg.hostname);
+        if (rule.by_app) add("app", msg.app_name);
+        if (rule.by_severity) add("sev", std::to_string(static_cast<int>(msg.severity)));
+        return key;
+    }
+
+    void AlertEngine::process(const SyslogMessage& msg, const Clock::time_point now) {
+        std::vector<Alert> fired;
+        Callback cb;
+        {
+            std::lock_guard lock(mutex_);
+            const auto ticks = now.time_since_epoch();
+
+            for (auto& st : states_) {
+                const auto& rule = st.rule;
+                if (static_cast<int>(msg.severity) > rule.max_severity) continue;
+                if (!rule.match_text.empty() && msg.message.find(rule.match_text) == std::string::npos) continue;
+
+                auto key = group_key(rule, msg);
+                auto& c = st.groups[key];
+                if (c.buckets.empty()) c.buckets.assign(rule.buckets, 0);
+
+                const int64_t idx = ticks / st.bucket_width;
+                if (c.head < 0 || idx - c.head >= static_cast<int64_t>(rule.buckets)) {
+                    std::fill(c.buckets.begin(), c.buckets.end(), 0);
+                    c.total = 0;
+                } else {
+                    // Expire the buckets that slid out of the window (at most `buckets` of them)
+                    for (int64_t i = c.head + 1; i <= idx; ++i) {
+                        auto& b = c.buckets[static_cast<size_t>(i % rule.buckets)];
+                        c.total -= b;
+                        b = 0;
+                    }
+                }
+                c.head = std::max(c.head, idx);
+
+                c.buckets[static_cast<size_t>(c.head % rule.buckets)]++;
+                c.total++;
+
+                const bool cooled = c.fired_at < 0 || c.head - c.fired_at >= static_cast<int64_t>(rule.buckets);
+                if (c.total > rule.threshold && cooled) {
+                    c.fired_at = c.head;
+                    fired.push_back({rule.name, std::move(key), c.total, rule.length});
+                }
+            }
+
+            if ((++processed_ & 0xFFF) == 0) evict_idle(ticks);
+            if (!fired.empty()) cb = callback_;
+        }
+        if (cb) {
+            for (const auto& alert : fired) cb(alert);
+        }
+    }
+
+    void AlertEngine::evict_idle(const Clock::duration now) {
+        // Groups whose whole window has expired hold no state worth keeping
+        for (auto& st : states_) {
+            const int64_t idx = now / st.bucket_width;
+            std::erase_if(st.groups, [&](const auto& kv) {
+                return idx - kv.second.head >= static_cast<int64_t>(st.rule.buckets);
+            });
+        }
+    }
+}
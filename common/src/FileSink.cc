@@ -0,0 +1,221 @@
+#include "SyslogKit/FileSink.hxx"
+#include "SyslogKit/Trace.hxx"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+
+#ifdef _WIN32
+    #include <io.h>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+#else
+    #include <sys/uio.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <climits>
+#endif
+
+namespace SyslogKit {
+
+    FileSink::FileSink() = default;
+    FileSink::~FileSink() { close(); }
+
+    bool FileSink::open(const FileSinkOptions& options) {
+        std::lock_guard lock(mutex_);
+        close_locked();
+        options_ = options;
+        return open_locked();
+    }
+
+    void FileSink::close() {
+        std::lock_guard lock(mutex_);
+        close_locked();
+    }
+
+    bool FileSink::is_open() {
+        std::lock_guard lock(mutex_);
+        return fd_ >= 0;
+    }
+
+    // Birth time of the open file, so rotation by age is not reset by a restart. Falls back to the
+    // modification time where the file system does not record one.
+    static std::chrono::system_clock::time_point file_created_at(const int fd) {
+        using clock = std::chrono::system_clock;
+    #ifdef _WIN32
+        struct _stat64 st{};
+        if (_fstat64(fd, &st) == 0) return clock::from_time_t(st.st_ctime); // creation time on Windows
+    #elif defined(__linux__) && defined(STATX_BTIME)
+        struct statx stx{};
+        if (::statx(fd, "", AT_EMPTY_PATH, STATX_BTIME | STATX_MTIME, &stx) == 0) {
+            const auto& t = (stx.stx_mask & STATX_BTIME) ? stx.stx_btime : stx.stx_mtime;
+            return clock::from_time_t(static_cast<std::time_t>(t.tv_sec));
+        }
+    #elif defined(__APPLE__)
+        struct stat st{};
+        if (::fstat(fd, &st) == 0) return clock::from_time_t(st.st_birthtimespec.tv_sec);
+    #else
+        struct stat st{};
+        if (::fstat(fd, &st) == 0) return clock::from_time_t(st.st_mtime);
+    #endif
+        return clock::now();
+    }
+
+    bool FileSink::open_locked() {
+        if (options_.path.empty()) return false;
+    #ifdef _WIN32
+        fd_ = _open(options_.path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+    #else
+        fd_ = ::open(options_.path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    #endif
+        if (fd_ < 0) return false;
+
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(options_.path, ec);
+        file_bytes_ = ec ? 0 : static_cast<uint64_t>(size);
+        created_at_ = file_created_at(fd_);
+        synced_at_ = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    void FileSink::close_locked() {
+        if (fd_ < 0) return;
+        flush_locked();
+    #ifdef _WIN32
+        _commit(fd_);
+        _close(fd_);
+    #else
+        ::fsync(fd_);
+        ::close(fd_);
+    #endif
+        fd_ = -1;
+        unsynced_ = false;
+    }
+
+    bool FileSink::rotate_locked() {
+        close_locked();
+
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        const auto& base = options_.path;
+        if (options_.keep == 0) {
+            fs::remove(base, ec);
+        } else {
+            fs::remove(base + "." + std::to_string(options_.keep), ec);
+            for (unsigned i = options_.keep - 1; i >= 1; --i) {
+                fs::rename(base + "." + std::to_string(i), base + "." + std::to_string(i + 1), ec);
+            }
+            fs::rename(base, base + ".1", ec);
+        }
+        return open_locked();
+    }
+
+    bool FileSink::flush_locked() {
+        if (used_ == 0) return true;
+        SYSLOGKIT_TRACE_SPAN("file.write");
+
+        bool ok = true;
+    #ifdef _WIN32
+        for (size_t i = 0; i < used_ && ok; ++i) {
+            const auto& buf = buffers_[i];
+            size_t off = 0;
+            while (off < buf.size()) {
+                const int n = _write(fd_, buf.data() + off, static_cast<unsigned>(buf.size() - off));
+                if (n <= 0) { ok = false; break; }
+                off += static_cast<size_t>(n);
+            }
+        }
+    #else
+        std::vector<iovec> iov(used_);
+        for (size_t i = 0; i < used_; ++i) {
+            iov[i].iov_base = buffers_[i].data();
+            iov[i].iov_len = buffers_[i].size();
+        }
+
+        // writev may write partially and accepts at most IOV_MAX entries per call
+        size_t first = 0;
+        while (first < iov.size()) {
+            const int count = static_cast<int>(std::min<size_t>(iov.size() - first, IOV_MAX));
+            const ssize_t n = ::writev(fd_, &iov[first], count);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                ok = false;
+                break;
+            }
+            auto left = static_cast<size_t>(n);
+            while (first < iov.size() && left >= iov[first].iov_len) {
+                left -= iov[first].iov_len;
+                first++;
+            }
+            if (left > 0) {
+                iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + left;
+                iov[first].iov_len -= left;
+            }
+        }
+    #endif
+
+        for (size_t i = 0; i < used_; ++i) buffers_[i].clear();
+        used_ = 0;
+
+        if (ok && options_.fsync_interval.count() > 0) {
+            unsynced_ = true;
+            if (std::chrono::steady_clock::now() - synced_at_ >= options_.fsync_interval) sync_locked();
+        }
+        return ok;
+    }
+
+    void FileSink::sync_locked() {
+        if (fd_ < 0 || !unsynced_) return;
+        SYSLOGKIT_TRACE_SPAN("file.fsync");
+    #ifdef _WIN32
+        _commit(fd_);
+    #elif defined(__APPLE__)
+        ::fsync(fd_);
+    #else
+        ::fdatasync(fd_);
+    #endif
+        synced_at_ = std::chrono::steady_clock::now();
+        unsynced_ = false;
+    }
+
+    void FileSink::sync() {
+        std::lock_guard lock(mutex_);
+        sync_locked();
+    }
+
+    bool FileSink::write_batch(const std::vector<SyslogMessage>& msgs) {
+        std::lock_guard lock(mutex_);
+        if (fd_ < 0) return false;
+
+        bool ok = true;
+        for (const auto& msg : msgs) {
+            if (used_ == 0 || buffers_[used_ - 1].size() >= kBufferSize) {
+                if (used_ == buffers_.size()) {
+                    buffers_.emplace_back();
+                    buffers_.back().reserve(kBufferSize + 1024);
+                }
+                used_++;
+            }
+            auto& buf = buffers_[used_ - 1];
+            const size_t before = buf.size();
+            SyslogBuilder::build_to(msg, buf);
+            buf += '\n';
+            file_bytes_ += buf.size() - before;
+
+            // Rotation is checked per message so a single large batch still splits at the limit
+            const bool by_size = options_.max_bytes > 0 && file_bytes_ >= options_.max_bytes;
+            if (by_size) {
+                ok = flush_locked() && ok;
+                ok = rotate_locked() && ok;
+                if (fd_ < 0) return false;
+            }
+        }
+        ok = flush_locked() && ok;
+
+        const bool by_age = options_.max_age.count() > 0 &&
+            std::chrono::system_clock::now() - created_at_ >= options_.max_age;
+        if (by_age && file_bytes_ > 0) ok = rotate_locked() && ok;
+        return ok;
+    }
+}
@@ -0,0 +1,181 @@
+#include "SyslogKit/LogImporter.hxx"
+#include "SyslogKit/Trace.hxx"
+#include <algorithm>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <string_view>
+#include <thread>
+
+#ifdef _WIN32
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace SyslogKit {
+
+    namespace {
+
+        // Read-only mapping of a whole file
+        class MappedFile {
+        public:
+            explicit MappedFile(const std::string& path) {
+            #ifdef _WIN32
+                file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                    OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+                if (file_ == INVALID_HANDLE_VALUE) return;
+                LARGE_INTEGER sz{};
+                if (!GetFileSizeEx(file_, &sz)) return;
+                if (sz.QuadPart == 0) { ok_ = true; return; } // empty files cannot be mapped
+                mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (!mapping_) return;
+                data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+                if (!data_) return;
+                size_ = static_cast<size_t>(sz.QuadPart);
+                ok_ = true;
+            #else
+                fd_ = ::open(path.c_str(), O_RDONLY);
+                if (fd_ < 0) return;
+                struct stat st{};
+                if (fstat(fd_, &st) != 0) return;
+                if (st.st_size == 0) { ok_ = true; return; } // empty files cannot be mapped
+                void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd_, 0);
+                if (p == MAP_FAILED) return;
+                madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(p);
+                size_ = static_cast<size_t>(st.st_size);
+                ok_ = true;
+            #endif
+            }
+
+            ~MappedFile() {
+            #ifdef _WIN32
+                if (data_) UnmapViewOfFile(data_);
+                if (mapping_) CloseHandle(mapping_);
+                if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+            #else
+                if (data_) munmap(const_cast<char*>(data_), size_);
+                if (fd_ >= 0) ::close(fd_);
+            #endif
+            }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            // False if the file could not be opened or mapped; an empty file is ok with an empty view
+            [[nodiscard]] bool ok() const { return ok_; }
+            [[nodiscard]] std::string_view view() const { return {data_, size_}; }
+
+        private:
+        #ifdef _WIN32
+            HANDLE file_ = INVALID_HANDLE_VALUE;
+            HANDLE mapping_ = nullptr;
+        #else
+            int fd_ = -1;
+        #endif
+            const char* data_ = nullptr;
+            size_t size_ = 0;
+            bool ok_ = false;
+        };
+
+        std::vector<SyslogMessage> parse_chunk(std::string_view chunk) {
+            SYSLOGKIT_TRACE_SPAN("import.parse_chunk");
+            std::vector<SyslogMessage> out;
+            out.reserve(chunk.size() / 128);
+            size_t start = 0;
+            while (start < chunk.size()) {
+                auto end = chunk.find('\n', start);
+                if (end == std::string_view::npos) end = chunk.size();
+                auto line = chunk.substr(start, end - start);
+                if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+                if (!line.empty()) out.push_back(SyslogBuilder::parse(line));
+                start = end + 1;
+            }
+            return out;
+        }
+    }
+
+    LogImporter::LogImporter(LogStorage& storage)
+        : storage_(storage), threads_(std::max(1u, std::thread::hardware_concurrency())) {}
+
+    std::vector<std::string> LogImporter::expand_rotated(const std::string& path) {
+        namespace fs = std::filesystem;
+        std::vector<std::string> res;
+        std::error_code ec;
+
+        std::vector<int> rotations;
+        const fs::path base(path);
+        const auto dir = base.has_parent_path() ? base.parent_path() : fs::path(".");
+        const auto prefix = base.filename().string() + ".";
+        for (const auto& entry : fs::directory_iterator(dir, ec)) {
+            const auto name = entry.path().filename().string();
+            if (!name.starts_with(prefix)) continue;
+            const auto suffix = std::string_view(name).substr(prefix.size());
+            if (suffix.empty() || !std::all_of(suffix.begin(), suffix.end(), [](char c) { return c >= '0' && c <= '9'; })) continue;
+            rotations.push_back(std::stoi(std::string(suffix)));
+        }
+        std::sort(rotations.rbegin(), rotations.rend());
+        for (const int n : rotations) {
+            res.push_back(path + "." + std::to_string(n));
+        }
+        if (fs::exists(base, ec)) res.push_back(path);
+        return res;
+    }
+
+    ImportStats LogImporter::import_files(const std::vector<std::string>& paths) {
+        ImportStats stats;
+        size_t bytes_total = 0;
+        for (const auto& p : paths) {
+            std::error_code ec;
+            const auto sz = std::filesystem::file_size(p, ec);
+            if (!ec) bytes_total += static_cast<size_t>(sz);
+        }
+
+        storage_.drop_indexes();
+        for (const auto& p : paths) {
+            if (import_file(p, bytes_total, stats)) stats.files++;
+            else stats.failed_files++;
+        }
+        storage_.create_indexes();
+        return stats;
+    }
+
+    bool LogImporter::import_file(const std::string& path, const size_t bytes_total, ImportStats& stats) {
+        const MappedFile file(path);
+        if (!file.ok()) return false;
+        const auto data = file.view();
+        if (data.empty()) return true;
+
+        // Keep at most threads_ chunks in flight; the oldest is written while the rest are parsed
+        std::deque<std::future<std::vector<SyslogMessage>>> inflight;
+        bool ok = true;
+        auto flush_front = [&] {
+            const auto rows = inflight.front().get();
+            inflight.pop_front();
+            if (!storage_.write_batch(rows)) ok = false;
+            else stats.rows += rows.size();
+        };
+
+        size_t pos = 0;
+        while (pos < data.size()) {
+            size_t end = std::min(pos + chunk_size_, data.size());
+            if (end < data.size()) {
+                const auto nl = data.find('\n', end);
+                end = (nl == std::string_view::npos) ? data.size() : nl + 1;
+            }
+            inflight.push_back(std::async(std::launch::async, parse_chunk, data.substr(pos, end - pos)));
+            stats.bytes += end - pos;
+            pos = end;
+
+            if (inflight.size() >= threads_) flush_front();
+            if (progress_) progress_(stats.bytes, bytes_total);
+        }
+        while (!inflight.empty()) flush_front();
+        return ok;
+    }
+}
@@ -1,13 +1,27 @@
 #include "SyslogKit/LogStorage.hxx"
+#include "SyslogKit/Trace.hxx"
 #include <sqlite3.h>
 #include <iostream>
+#include <algorithm>
+#include <future>
+#include <queue>
+#include <chrono>
 
 namespace SyslogKit {
 
     LogStorage::LogStorage() = default;
-    LogStorage::~LogStorage() { close(); }
+    LogStorage::~LogStorage() {
+        close_archives();
+        close();
+    }
 
     void LogStorage::close() {
+        stop_backfill();
+        std::lock_guard lock(mutex_);
+        close_locked();
+    }
+
+    void LogStorage::close_locked() {
         if (db_) {
             sqlite3_close(db_);
             db_ = nullptr;
@@ -15,84 +29,558 @@ namespace SyslogKit {
     }
 
     bool LogStorage::open(const std::string& path) {
-        close(); // сlose previous if open
-        if (sqlite3_open(path.c_str(), &db_) != SQLITE_OK) return false;
+        stop_backfill();
+        int64_t head;
+        {
+            std::lock_guard lock(mutex_);
+            close_locked(); // сlose previous if open
+            if (sqlite3_open(path.c_str(), &db_) != SQLITE_OK) return false;
 
-        db_path_ = path;
-        init_table();
+            db_path_ = path;
+            init_table();
 
-        sqlite3_exec(db_, "PRAGMA synchronous = NORMAL;", nullptr, nullptr, nullptr);
-        sqlite3_exec(db_, "PRAGMA journal_mode = WAL;", nullptr, nullptr, nullptr);
+            sqlite3_exec(db_, "PRAGMA synchronous = NORMAL;", nullptr, nullptr, nullptr);
+            sqlite3_exec(db_, "PRAGMA journal_mode = WAL;", nullptr, nullptr, nullptr);
+            head = head_id_locked();
+            if (backfill_end_ > 0) backfill_ = std::jthread([this](const std::stop_token stop) { backfill_sort_keys(stop); });
+        }
 
+        // Row ids of the previous database are meaningless here: tail from the new head
+        std::lock_guard subs_lock(subs_mutex_);
+        for (const auto& sub : subs_) {
+            std::lock_guard sub_lock(sub->mutex);
+            sub->last_id = head;
+        }
         return true;
     }
 
+    static int64_t now_ms() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    static bool has_sort_key(sqlite3* db) {
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(db, "SELECT 1 FROM pragma_table_info('logs') WHERE name = 'ts_sort'",
+                               -1, &stmt, nullptr) != SQLITE_OK) return false;
+        const bool found = sqlite3_step(stmt) == SQLITE_ROW;
+        sqlite3_finalize(stmt);
+        return found;
+    }
+
+    // syslogkit_ts_sort(ts, now_ms): SyslogBuilder::timestamp_to_epoch_ms for the backfill UPDATE
+    static void ts_sort_function(sqlite3_context* ctx, int, sqlite3_value** argv) {
+        const auto* ts = reinterpret_cast<const char *>(sqlite3_value_text(argv[0]));
+        const auto len = static_cast<size_t>(sqlite3_value_bytes(argv[0]));
+        sqlite3_result_int64(ctx, SyslogBuilder::timestamp_to_epoch_ms(std::string_view(ts ? ts : "", len),
+                                                                        sqlite3_value_int64(argv[1])));
+    }
+
     void LogStorage::init_table() {
         const auto sql = R"(
             CREATE TABLE IF NOT EXISTS logs (
                 id INTEGER PRIMARY KEY AUTOINCREMENT,
                 fac INTEGER, sev INTEGER,
-                ts TEXT, host TEXT, app TEXT, msg TEXT
+                ts TEXT, host TEXT, app TEXT, msg TEXT,
+                ts_sort INTEGER -- ts as ms since the epoch, see SyslogBuilder::timestamp_to_epoch_ms
             );
-            CREATE INDEX IF NOT EXISTS idx_ts ON logs(ts);
+            CREATE TABLE IF NOT EXISTS sd (
+                param TEXT NOT NULL, value TEXT NOT NULL, sd_id TEXT NOT NULL,
+                log_id INTEGER NOT NULL,
+                PRIMARY KEY (param, value, sd_id, log_id)
+            ) WITHOUT ROWID;
         )";
         char* errMsg = nullptr;
         sqlite3_exec(db_, sql, nullptr, nullptr, &errMsg);
         if (errMsg) {
             sqlite3_free(errMsg);
         }
-    }
+        // Databases created before ts_sort existed get the column here and the values from the backfill
+        // thread, so opening a large database does not block on rewriting every row
+        if (!has_sort_key(db_)) sqlite3_exec(db_, "ALTER TABLE logs ADD COLUMN ts_sort INTEGER;", nullptr, nullptr, nullptr);
+        sqlite3_create_function_v2(db_, "syslogkit_ts_sort", 2, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr,
+                                   ts_sort_function, nullptr, nullptr, nullptr);
 
-    bool LogStorage::write(const SyslogMessage& msg) {
-        if (!db_) return false;
-        const auto sql = "INSERT INTO logs (fac, sev, ts, host, app, msg) VALUES (?,?,?,?,?,?)";
+        backfill_end_ = 0;
         sqlite3_stmt* stmt;
-        if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) != SQLITE_OK) return false;
+        if (sqlite3_prepare_v2(db_, "SELECT id FROM logs WHERE ts_sort IS NULL ORDER BY id DESC LIMIT 1",
+                               -1, &stmt, nullptr) == SQLITE_OK) {
+            if (sqlite3_step(stmt) == SQLITE_ROW) backfill_end_ = sqlite3_column_int64(stmt, 0);
+            sqlite3_finalize(stmt);
+        }
+        create_indexes_locked();
+    }
 
+    void LogStorage::create_indexes_locked() {
+        sqlite3_exec(db_, "CREATE INDEX IF NOT EXISTS idx_ts ON logs(ts);", nullptr, nullptr, nullptr);
+        sqlite3_exec(db_, "CREATE INDEX IF NOT EXISTS idx_sd_log ON sd(log_id);", nullptr, nullptr, nullptr);
+        // Built by the backfill thread once every row has its key
+        if (backfill_end_ == 0) {
+            sqlite3_exec(db_, "CREATE INDEX IF NOT EXISTS idx_ts_sort ON logs(ts_sort);", nullptr, nullptr, nullptr);
+        }
+    }
+
+    void LogStorage::stop_backfill() {
+        if (!backfill_.joinable()) return;
+        backfill_.request_stop();
+        backfill_.join();
+    }
+
+    // Fills ts_sort downwards from backfill_end_ in short transactions, releasing the lock between
+    // chunks so writers and queries interleave. Rows not reached yet use the on-read fallback of
+    // select_archive(); an interrupted backfill resumes on the next open().
+    void LogStorage::backfill_sort_keys(const std::stop_token stop) {
+        static constexpr int64_t kChunk = 5000;
+        const auto now = now_ms();
+        while (!stop.stop_requested()) {
+            {
+                std::lock_guard lock(mutex_);
+                if (!db_ || backfill_end_ <= 0) return;
+
+                sqlite3_stmt* stmt;
+                const auto sql = "UPDATE logs SET ts_sort = syslogkit_ts_sort(ts, ?) "
+                                 "WHERE id > ? AND id <= ? AND ts_sort IS NULL";
+                if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) != SQLITE_OK) return;
+                sqlite3_bind_int64(stmt, 1, now);
+                sqlite3_bind_int64(stmt, 2, backfill_end_ - kChunk);
+                sqlite3_bind_int64(stmt, 3, backfill_end_);
+                const bool ok = sqlite3_step(stmt) == SQLITE_DONE;
+                sqlite3_finalize(stmt);
+                if (!ok) return;
+
+                backfill_end_ = std::max<int64_t>(backfill_end_ - kChunk, 0);
+                if (backfill_end_ == 0) {
+                    sqlite3_exec(db_, "CREATE INDEX IF NOT EXISTS idx_ts_sort ON logs(ts_sort);", nullptr, nullptr, nullptr);
+                    return;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    void LogStorage::drop_indexes() {
+        std::lock_guard lock(mutex_);
+        if (!db_) return;
+        // idx_sd_log stays: tail subscribers load structured data by log_id while the import runs
+        sqlite3_exec(db_, "DROP INDEX IF EXISTS idx_ts;", nullptr, nullptr, nullptr);
+        sqlite3_exec(db_, "DROP INDEX IF EXISTS idx_ts_sort;", nullptr, nullptr, nullptr);
+    }
+
+    void LogStorage::create_indexes() {
+        std::lock_guard lock(mutex_);
+        if (!db_) return;
+        create_indexes_locked();
+    }
+
+    static void bind_message(sqlite3_stmt* stmt, const SyslogMessage& msg, const int64_t now) {
         sqlite3_bind_int(stmt, 1, static_cast<int>(msg.facility));
         sqlite3_bind_int(stmt, 2, static_cast<int>(msg.severity));
         sqlite3_bind_text(stmt, 3, msg.timestamp.c_str(), -1, SQLITE_STATIC);
         sqlite3_bind_text(stmt, 4, msg.hostname.c_str(), -1, SQLITE_STATIC);
         sqlite3_bind_text(stmt, 5, msg.app_name.c_str(), -1, SQLITE_STATIC);
         sqlite3_bind_text(stmt, 6, msg.message.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_int64(stmt, 7, SyslogBuilder::timestamp_to_epoch_ms(msg.timestamp, now));
+    }
+
+    static constexpr auto kInsertSql = "INSERT INTO logs (fac, sev, ts, host, app, msg, ts_sort) VALUES (?,?,?,?,?,?,?)";
+    static constexpr auto kInsertSdSql = "INSERT OR IGNORE INTO sd (param, value, sd_id, log_id) VALUES (?,?,?,?)";
+
+    bool LogStorage::insert_locked(const std::span<const SyslogMessage> msgs) {
+        SYSLOGKIT_TRACE_SPAN("storage.write");
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(db_, kInsertSql, -1, &stmt, nullptr) != SQLITE_OK) return false;
+        sqlite3_stmt* sd_stmt;
+        if (sqlite3_prepare_v2(db_, kInsertSdSql, -1, &sd_stmt, nullptr) != SQLITE_OK) {
+            sqlite3_finalize(stmt);
+            return false;
+        }
+        sqlite3_exec(db_, "BEGIN;", nullptr, nullptr, nullptr);
+
+        bool ok = true;
+        const auto now = now_ms();
+        for (const auto& msg : msgs) {
+            bind_message(stmt, msg, now);
+            if (sqlite3_step(stmt) != SQLITE_DONE) { ok = false; break; }
+            sqlite3_reset(stmt);
 
-        const bool ok = (sqlite3_step(stmt) == SQLITE_DONE);
+            const auto log_id = sqlite3_last_insert_rowid(db_);
+            for (const auto& el : msg.structured_data) {
+                for (const auto& [name, value] : el.params) {
+                    sqlite3_bind_text(sd_stmt, 1, name.c_str(), -1, SQLITE_STATIC);
+                    sqlite3_bind_text(sd_stmt, 2, value.c_str(), -1, SQLITE_STATIC);
+                    sqlite3_bind_text(sd_stmt, 3, el.id.c_str(), -1, SQLITE_STATIC);
+                    sqlite3_bind_int64(sd_stmt, 4, log_id);
+                    if (sqlite3_step(sd_stmt) != SQLITE_DONE) ok = false;
+                    sqlite3_reset(sd_stmt);
+                }
+            }
+            if (!ok) break;
+        }
         sqlite3_finalize(stmt);
+        sqlite3_finalize(sd_stmt);
+
+        SYSLOGKIT_TRACE_SPAN("storage.commit");
+        sqlite3_exec(db_, ok ? "COMMIT;" : "ROLLBACK;", nullptr, nullptr, nullptr);
         return ok;
     }
 
-    std::vector<SyslogMessage> LogStorage::query(const LogFilter& filter) {
-        std::vector<SyslogMessage> res;
-        if (!db_) return res;
+    bool LogStorage::write(const SyslogMessage& msg) {
+        bool ok;
+        {
+            std::lock_guard lock(mutex_);
+            if (!db_) return false;
+            ok = insert_locked({&msg, 1});
+        }
+        if (ok) notify_subscribers();
+        return ok;
+    }
 
-        std::string sql = "SELECT fac, sev, ts, host, app, msg FROM logs WHERE 1=1";
+    bool LogStorage::write_batch(const std::vector<SyslogMessage>& msgs) {
+        if (msgs.empty()) return true;
+        bool ok;
+        {
+            std::lock_guard lock(mutex_);
+            if (!db_) return false;
+            ok = insert_locked(msgs);
+        }
+        if (ok) notify_subscribers();
+        return ok;
+    }
+
+    static void append_filter_sql(std::string& sql, const LogFilter& filter) {
         if (!filter.search_text.empty()) sql += " AND msg LIKE ?";
-        sql += " ORDER BY id DESC";
+        if (filter.min_severity >= 0) sql += " AND sev <= ?";
+        for (const auto& match : filter.sd_match) {
+            // Resolved through the sd primary key, not by scanning logs
+            sql += match.sd_id.empty()
+                ? " AND id IN (SELECT log_id FROM sd WHERE param = ? AND value = ?)"
+                : " AND id IN (SELECT log_id FROM sd WHERE param = ? AND value = ? AND sd_id = ?)";
+        }
+    }
+
+    static int bind_filter(sqlite3_stmt* stmt, const LogFilter& filter, int idx) {
+        if (!filter.search_text.empty()) {
+            const std::string s = "%" + filter.search_text + "%";
+            sqlite3_bind_text(stmt, idx++, s.c_str(), -1, SQLITE_TRANSIENT);
+        }
+        if (filter.min_severity >= 0) sqlite3_bind_int(stmt, idx++, filter.min_severity);
+        for (const auto& match : filter.sd_match) {
+            sqlite3_bind_text(stmt, idx++, match.param.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(stmt, idx++, match.value.c_str(), -1, SQLITE_TRANSIENT);
+            if (!match.sd_id.empty()) sqlite3_bind_text(stmt, idx++, match.sd_id.c_str(), -1, SQLITE_TRANSIENT);
+        }
+        return idx;
+    }
+
+    static std::string column_string(sqlite3_stmt* stmt, const int col) {
+        const auto* text = reinterpret_cast<const char *>(sqlite3_column_text(stmt, col));
+        return text ? text : "";
+    }
+
+    static SyslogMessage read_row(sqlite3_stmt* stmt) {
+        SyslogMessage m;
+        m.facility = static_cast<Facility>(sqlite3_column_int(stmt, 0));
+        m.severity = static_cast<Severity>(sqlite3_column_int(stmt, 1));
+        m.timestamp = column_string(stmt, 2);
+        m.hostname = column_string(stmt, 3);
+        m.app_name = column_string(stmt, 4);
+        m.message = column_string(stmt, 5);
+        return m;
+    }
+
+    static void load_structured_data(sqlite3* db, std::vector<SyslogMessage>& rows, const std::vector<int64_t>& ids) {
+        if (rows.empty()) return;
+        sqlite3_stmt* stmt;
+        const auto sql = "SELECT sd_id, param, value FROM sd WHERE log_id = ? ORDER BY sd_id";
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) return;
+
+        for (size_t i = 0; i < rows.size(); ++i) {
+            sqlite3_bind_int64(stmt, 1, ids[i]);
+            auto& sd = rows[i].structured_data;
+            while (sqlite3_step(stmt) == SQLITE_ROW) {
+                auto sd_id = column_string(stmt, 0);
+                if (sd.empty() || sd.back().id != sd_id) sd.push_back({std::move(sd_id), {}});
+                sd.back().params.push_back({column_string(stmt, 1), column_string(stmt, 2)});
+            }
+            sqlite3_reset(stmt);
+        }
+        sqlite3_finalize(stmt);
+    }
+
+    // Newest-first filtered select shared by the main database and read-only archives
+    static std::vector<SyslogMessage> select_rows(sqlite3* db, const LogFilter& filter, const char* order_by) {
+        std::vector<SyslogMessage> res;
+        std::string sql = "SELECT fac, sev, ts, host, app, msg, id FROM logs WHERE 1=1";
+        append_filter_sql(sql, filter);
+        sql += " ORDER BY ";
+        sql += order_by;
 
         if (filter.limit > 0) {
             sql += " LIMIT ?";
         }
         sqlite3_stmt* stmt;
-        if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) return res;
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) return res;
 
-        int idx = 1;
-        if (!filter.search_text.empty()) {
-            const std::string s = "%" + filter.search_text + "%";
-            sqlite3_bind_text(stmt, idx++, s.c_str(), -1, SQLITE_TRANSIENT);
+        int idx = bind_filter(stmt, filter, 1);
+        if (filter.limit > 0) sqlite3_bind_int(stmt, idx++, filter.limit);
+
+        std::vector<int64_t> ids;
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            res.push_back(read_row(stmt));
+            ids.push_back(sqlite3_column_int64(stmt, 6));
+        }
+        sqlite3_finalize(stmt);
+        load_structured_data(db, res, ids);
+        return res;
+    }
+
+    struct ArchivePart {
+        std::vector<SyslogMessage> rows;
+        std::vector<int64_t> sort_keys;
+    };
+
+    struct SortKey {
+        int64_t key;
+        int64_t id;
+    };
+
+    // Appends (ts_sort, id) of the rows matching filter and where. With stored == false only ts is read
+    // and the key is computed here, for rows that have no ts_sort (yet).
+    static void select_sort_keys(sqlite3* db, const LogFilter& filter, const char* where, const bool stored,
+                                 std::vector<SortKey>& out) {
+        std::string sql = stored ? "SELECT id, ts_sort FROM logs WHERE " : "SELECT id, ts FROM logs WHERE ";
+        sql += where;
+        append_filter_sql(sql, filter);
+        if (stored) {
+            sql += " ORDER BY ts_sort DESC, id DESC";
+            if (filter.limit > 0) sql += " LIMIT ?";
+        }
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) return;
+
+        const int idx = bind_filter(stmt, filter, 1);
+        if (stored && filter.limit > 0) sqlite3_bind_int(stmt, idx, filter.limit);
+
+        const auto now = now_ms();
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            const auto id = sqlite3_column_int64(stmt, 0);
+            if (stored) {
+                out.push_back({sqlite3_column_int64(stmt, 1), id});
+            } else {
+                const auto* ts = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1));
+                const auto len = static_cast<size_t>(sqlite3_column_bytes(stmt, 1));
+                out.push_back({SyslogBuilder::timestamp_to_epoch_ms(std::string_view(ts ? ts : "", len), now), id});
+            }
+        }
+        sqlite3_finalize(stmt);
+    }
+
+    // One archive's matches, newest first by ts_sort. Only (key, id) pairs are ranked; the rows that
+    // survive filter.limit are then read in full, structured data included.
+    static ArchivePart select_archive(sqlite3* db, const LogFilter& filter) {
+        std::vector<SortKey> keys;
+        if (has_sort_key(db)) {
+            select_sort_keys(db, filter, "ts_sort IS NOT NULL", true, keys);
+            select_sort_keys(db, filter, "ts_sort IS NULL", false, keys);
+        } else {
+            select_sort_keys(db, filter, "1=1", false, keys); // archive written before ts_sort existed
         }
-        sqlite3_bind_int(stmt, idx++, filter.limit);
 
+        auto newer = [](const SortKey& a, const SortKey& b) { return a.key != b.key ? a.key > b.key : a.id > b.id; };
+        const size_t n = filter.limit > 0 ? std::min(keys.size(), static_cast<size_t>(filter.limit)) : keys.size();
+        std::partial_sort(keys.begin(), keys.begin() + static_cast<std::ptrdiff_t>(n), keys.end(), newer);
+        keys.resize(n);
+
+        ArchivePart part;
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(db, "SELECT fac, sev, ts, host, app, msg FROM logs WHERE id = ?", -1, &stmt, nullptr) != SQLITE_OK) {
+            return part;
+        }
+        std::vector<int64_t> ids;
+        part.rows.reserve(n);
+        for (const auto& k : keys) {
+            sqlite3_bind_int64(stmt, 1, k.id);
+            if (sqlite3_step(stmt) == SQLITE_ROW) {
+                part.rows.push_back(read_row(stmt));
+                part.sort_keys.push_back(k.key);
+                ids.push_back(k.id);
+            }
+            sqlite3_reset(stmt);
+        }
+        sqlite3_finalize(stmt);
+        load_structured_data(db, part.rows, ids);
+        return part;
+    }
+
+    int64_t LogStorage::head_id_locked() const {
+        int64_t head = 0;
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(db_, "SELECT MAX(id) FROM logs", -1, &stmt, nullptr) != SQLITE_OK) return head;
+        if (sqlite3_step(stmt) == SQLITE_ROW) head = sqlite3_column_int64(stmt, 0);
+        sqlite3_finalize(stmt);
+        return head;
+    }
+
+    int64_t LogStorage::head_id() {
+        std::lock_guard lock(mutex_);
+        return db_ ? head_id_locked() : 0;
+    }
+
+    std::vector<SyslogMessage> LogStorage::query(const LogFilter& filter, int64_t* head_id) {
+        SYSLOGKIT_TRACE_SPAN("storage.query");
+        std::lock_guard lock(mutex_);
+        std::vector<SyslogMessage> res;
+        if (!db_) return res;
+        if (head_id) *head_id = head_id_locked();
+        return select_rows(db_, filter, "id DESC");
+    }
+
+    std::vector<SyslogMessage> LogStorage::query_since(const LogFilter& filter, int64_t& last_id) {
+        std::lock_guard lock(mutex_);
+        std::vector<SyslogMessage> res;
+        if (!db_) return res;
+
+        // Range scan on the rowid: cost is proportional to the rows committed after last_id.
+        // With a limit only the newest rows are read; older ones would be trimmed by the viewer anyway.
+        std::string sql = "SELECT fac, sev, ts, host, app, msg, id FROM logs WHERE id > ?";
+        append_filter_sql(sql, filter);
+        sql += " ORDER BY id DESC";
+        if (filter.limit > 0) sql += " LIMIT ?";
+
+        sqlite3_stmt* stmt;
+        if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) return res;
+
+        sqlite3_bind_int64(stmt, 1, last_id);
+        const int idx = bind_filter(stmt, filter, 2);
+        if (filter.limit > 0) sqlite3_bind_int(stmt, idx, filter.limit);
+
+        std::vector<int64_t> ids;
         while (sqlite3_step(stmt) == SQLITE_ROW) {
-            SyslogMessage m;
-            m.facility = static_cast<Facility>(sqlite3_column_int(stmt, 0));
-            m.severity = static_cast<Severity>(sqlite3_column_int(stmt, 1));
-            m.timestamp = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 2));
-            m.hostname = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 3));
-            m.app_name = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 4));
-            m.message = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 5));
-            res.push_back(m);
+            res.push_back(read_row(stmt));
+            ids.push_back(sqlite3_column_int64(stmt, 6));
         }
         sqlite3_finalize(stmt);
+        load_structured_data(db_, res, ids);
+        std::reverse(res.begin(), res.end());
+
+        // Skipped rows (non-matching or beyond the limit) are consumed too: the next scan starts at the head
+        last_id = std::max(last_id, head_id_locked());
         return res;
     }
-}
\ No newline at end of file
+
+    bool LogStorage::open_archives(const std::vector<std::string>& paths) {
+        close_archives();
+        std::lock_guard lock(archives_mutex_);
+        for (const auto& path : paths) {
+            sqlite3* db = nullptr;
+            if (sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+                sqlite3_close(db);
+                for (auto* opened : archives_) sqlite3_close(opened);
+                archives_.clear();
+                archive_paths_.clear();
+                return false;
+            }
+            archives_.push_back(db);
+            archive_paths_.push_back(path);
+        }
+        return true;
+    }
+
+    void LogStorage::close_archives() {
+        std::lock_guard lock(archives_mutex_);
+        for (auto* db : archives_) sqlite3_close(db);
+        archives_.clear();
+        archive_paths_.clear();
+    }
+
+    std::vector<std::string> LogStorage::archive_paths() {
+        std::lock_guard lock(archives_mutex_);
+        return archive_paths_;
+    }
+
+    std::vector<SyslogMessage> LogStorage::query_archives(const LogFilter& filter) {
+        SYSLOGKIT_TRACE_SPAN("storage.query_archives");
+        std::lock_guard lock(archives_mutex_);
+        std::vector<SyslogMessage> res;
+        if (archives_.empty()) return res;
+
+        // Each connection is used by exactly one worker; every per-file result is sorted newest first
+        std::vector<std::future<ArchivePart>> workers;
+        workers.reserve(archives_.size());
+        for (auto* db : archives_) {
+            workers.push_back(std::async(std::launch::async, select_archive, db, std::cref(filter)));
+        }
+        std::vector<ArchivePart> parts;
+        parts.reserve(workers.size());
+        for (auto& w : workers) parts.push_back(w.get());
+
+        // k-way merge: heap of per-file cursors ordered by their current row's sort key
+        struct Cursor {
+            size_t part;
+            size_t row;
+        };
+        auto older = [&parts](const Cursor& a, const Cursor& b) {
+            const auto ta = parts[a.part].sort_keys[a.row];
+            const auto tb = parts[b.part].sort_keys[b.row];
+            return ta != tb ? ta < tb : a.part > b.part;
+        };
+        std::priority_queue<Cursor, std::vector<Cursor>, decltype(older)> heap(older);
+        size_t total = 0;
+        for (size_t i = 0; i < parts.size(); ++i) {
+            total += parts[i].rows.size();
+            if (!parts[i].rows.empty()) heap.push({i, 0});
+        }
+
+        const size_t limit = filter.limit > 0 ? static_cast<size_t>(filter.limit) : total;
+        res.reserve(std::min(limit, total));
+        while (!heap.empty() && res.size() < limit) {
+            const auto cur = heap.top();
+            heap.pop();
+            res.push_back(std::move(parts[cur.part].rows[cur.row]));
+            if (cur.row + 1 < parts[cur.part].rows.size()) heap.push({cur.part, cur.row + 1});
+        }
+        return res;
+    }
+
+    int LogStorage::subscribe(const LogFilter& filter, const int64_t last_id, TailCallback cb) {
+        auto sub = std::make_shared<Subscription>();
+        sub->filter = filter;
+        sub->last_id = last_id;
+        sub->callback = std::move(cb);
+
+        std::lock_guard lock(subs_mutex_);
+        sub->id = next_sub_id_++;
+        subs_.push_back(sub);
+        return sub->id;
+    }
+
+    void LogStorage::unsubscribe(const int id) {
+        std::shared_ptr<Subscription> removed;
+        {
+            std::lock_guard lock(subs_mutex_);
+            const auto it = std::find_if(subs_.begin(), subs_.end(), [id](const auto& s) { return s->id == id; });
+            if (it == subs_.end()) return;
+            removed = *it;
+            subs_.erase(it);
+        }
+        // Wait for an in-flight notification so the callback is not invoked after unsubscribe returns
+        std::lock_guard lock(removed->mutex);
+        removed->callback = nullptr;
+    }
+
+    void LogStorage::notify_subscribers() {
+        SYSLOGKIT_TRACE_SPAN("storage.notify");
+        std::vector<std::shared_ptr<Subscription>> subs;
+        {
+            std::lock_guard lock(subs_mutex_);
+            if (subs_.empty()) return;
+            subs = subs_;
+        }
+        for (const auto& sub : subs) {
+            std::lock_guard lock(sub->mutex);
+            if (!sub->callback) continue;
+            auto rows = query_since(sub->filter, sub->last_id);
+            if (!rows.empty()) sub->callback(std::move(rows));
+        }
+    }
+}
@@ -0,0 +1,158 @@
+#include "SyslogKit/OverloadController.hxx"
+#include "SyslogKit/Trace.hxx"
+#include <algorithm>
+
+namespace SyslogKit {
+
+    OverloadController::OverloadController(Sink sink) : sink_(std::move(sink)) {}
+    OverloadController::~OverloadController() { stop(); }
+
+    void OverloadController::start() {
+        std::lock_guard lock(mutex_);
+        if (running_) return;
+        running_ = true;
+        writer_ = std::jthread(&OverloadController::writer_loop, this);
+    }
+
+    void OverloadController::stop() {
+        {
+            std::lock_guard lock(mutex_);
+            if (!running_) return;
+            running_ = false;
+        }
+        cv_.notify_all();
+        if (writer_.joinable()) writer_.join();
+    }
+
+    int OverloadController::compute_level(const size_t depth) const {
+        // Pressure is the worse of queue fill and the estimated time to drain the queue at the
+        // current sink speed, so a slow sink escalates before the queue fills up
+        const double fill = static_cast<double>(depth) / static_cast<double>(capacity_);
+        const double drain_us = static_cast<double>(depth) * write_us_per_msg_.load(std::memory_order_relaxed);
+        const double pressure = std::max(fill, drain_us / max_drain_us_);
+
+        if (pressure >= 0.75) return 3;
+        if (pressure >= 0.5) return 2;
+        if (pressure >= 0.25) return 1;
+        return 0;
+    }
+
+    static size_t queue_index(const Severity sev) {
+        return sev <= Severity::Warning ? 0 : static_cast<size_t>(sev) - static_cast<size_t>(Severity::Warning);
+    }
+
+    size_t OverloadController::depth_locked() const {
+        size_t depth = 0;
+        for (const auto& q : queues_) depth += q.size();
+        return depth;
+    }
+
+    // Makes room for a Warning-or-above message by dropping the newest message of the lowest queued severity
+    bool OverloadController::evict_low_locked() {
+        for (size_t i = queues_.size() - 1; i > 0; --i) {
+            if (queues_[i].empty()) continue;
+            const int sev = std::clamp(static_cast<int>(queues_[i].back().msg.severity), 0, 7);
+            queues_[i].pop_back();
+            accepted_[sev].fetch_sub(1, std::memory_order_relaxed);
+            shed_[sev].fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    bool OverloadController::admit(const Severity sev, const int level, const size_t depth) {
+        if (sev <= Severity::Warning) return depth < capacity_ * 2 || evict_low_locked();
+        if (depth >= capacity_) return false;
+
+        uint64_t rate = 1;
+        if (sev == Severity::Debug) {
+            static constexpr uint64_t kDebugRate[] = {1, 10, 100, 0};
+            rate = kDebugRate[level];
+        } else {
+            static constexpr uint64_t kInfoRate[] = {1, 1, 10, 100};
+            rate = kInfoRate[level];
+        }
+        if (rate == 0) return false;
+        if (rate == 1) return true;
+        const auto seq = sample_seq_[static_cast<int>(sev)].fetch_add(1, std::memory_order_relaxed);
+        return seq % rate == 0;
+    }
+
+    bool OverloadController::offer(SyslogMessage msg) {
+        const int sev = std::clamp(static_cast<int>(msg.severity), 0, 7);
+        {
+            std::lock_guard lock(mutex_);
+            const size_t depth = depth_locked();
+            if (!running_ || !admit(msg.severity, compute_level(depth), depth)) {
+                shed_[sev].fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            // Counted under the lock: a later eviction of this message moves it from accepted to shed
+            accepted_[sev].fetch_add(1, std::memory_order_relaxed);
+            queues_[queue_index(msg.severity)].push_back({next_seq_++, std::move(msg)});
+        }
+        cv_.notify_one();
+        return true;
+    }
+
+    void OverloadController::writer_loop() {
+        SYSLOGKIT_TRACE_THREAD("ingest");
+        std::vector<SyslogMessage> batch;
+        batch.reserve(batch_size_);
+
+        while (true) {
+            {
+                std::unique_lock lock(mutex_);
+                const auto ready = [this] { return depth_locked() > 0 || !running_; };
+                if (!idle_) {
+                    cv_.wait(lock, ready);
+                } else if (!cv_.wait_for(lock, idle_after_, ready)) {
+                    lock.unlock();
+                    idle_();
+                    continue;
+                }
+                if (depth_locked() == 0 && !running_) break;
+
+                // Merge the per-class queues back into arrival order
+                while (batch.size() < batch_size_) {
+                    std::deque<Queued>* next = nullptr;
+                    for (auto& q : queues_) {
+                        if (!q.empty() && (!next || q.front().seq < next->front().seq)) next = &q;
+                    }
+                    if (!next) break;
+                    batch.push_back(std::move(next->front().msg));
+                    next->pop_front();
+                }
+            }
+
+            const auto t0 = std::chrono::steady_clock::now();
+            {
+                SYSLOGKIT_TRACE_SPAN("ingest.sink");
+                sink_(batch);
+            }
+            const auto us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+
+            // EWMA of per-message sink cost
+            const double sample = us / static_cast<double>(std::max<size_t>(batch.size(), 1));
+            const double prev = write_us_per_msg_.load(std::memory_order_relaxed);
+            write_us_per_msg_.store(prev * 0.8 + sample * 0.2, std::memory_order_relaxed);
+
+            batch.clear();
+        }
+    }
+
+    OverloadStats OverloadController::stats() const {
+        OverloadStats s;
+        for (size_t i = 0; i < 8; ++i) {
+            s.accepted[i] = accepted_[i].load(std::memory_order_relaxed);
+            s.shed[i] = shed_[i].load(std::memory_order_relaxed);
+        }
+        {
+            std::lock_guard lock(mutex_);
+            s.queue_depth = depth_locked();
+            s.level = compute_level(s.queue_depth);
+        }
+        s.write_us_per_msg = write_us_per_msg_.load(std::memory_order_relaxed);
+        return s;
+    }
+}
@@ -0,0 +1,228 @@
+#include "SyslogKit/RingFile.hxx"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#ifdef _WIN32
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace SyslogKit {
+
+    namespace {
+
+        constexpr char kMagic[8] = {'S', 'K', 'R', 'I', 'N', 'G', '0', '1'};
+        constexpr uint32_t kVersion = 1;
+        constexpr size_t kHeaderSize = 4096;
+
+        struct RingHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t slot_count;
+            uint32_t slot_size;
+            uint32_t checksum;   // over the fields above
+            uint64_t write_seq;  // hint only; recovery trusts the slots
+            uint64_t clear_seq;  // slots below this were cleared
+        };
+
+        struct SlotHeader {
+            uint64_t seq;        // 0 = empty
+            uint32_t checksum;   // over everything after this field
+            uint8_t facility;
+            uint8_t severity;
+            uint16_t ts_len;
+            uint16_t host_len;
+            uint16_t app_len;
+            uint32_t msg_len;
+        };
+
+        uint32_t fnv1a(const unsigned char* p, const size_t n, uint32_t h = 2166136261u) {
+            for (size_t i = 0; i < n; ++i) {
+                h ^= p[i];
+                h *= 16777619u;
+            }
+            return h;
+        }
+
+        uint32_t header_checksum(const RingHeader& h) {
+            return fnv1a(reinterpret_cast<const unsigned char*>(&h), offsetof(RingHeader, checksum));
+        }
+
+        uint32_t slot_checksum(const unsigned char* slot, const size_t payload) {
+            const auto* hdr = reinterpret_cast<const SlotHeader*>(slot);
+            uint32_t h = fnv1a(reinterpret_cast<const unsigned char*>(&hdr->seq), sizeof(hdr->seq));
+            constexpr size_t fields = offsetof(SlotHeader, facility);
+            return fnv1a(slot + fields, sizeof(SlotHeader) - fields + payload, h);
+        }
+    }
+
+    RingFile::RingFile() = default;
+    RingFile::~RingFile() { close(); }
+
+    bool RingFile::map(const std::string& path, const size_t size, bool& created) {
+    #ifdef _WIN32
+        file_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                            OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) { file_ = nullptr; return false; }
+        LARGE_INTEGER cur{};
+        GetFileSizeEx(file_, &cur);
+        created = static_cast<size_t>(cur.QuadPart) != size;
+        LARGE_INTEGER sz{};
+        sz.QuadPart = static_cast<LONGLONG>(size);
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READWRITE, sz.HighPart, sz.LowPart, nullptr);
+        if (!mapping_) return false;
+        base_ = static_cast<unsigned char*>(MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, size));
+    #else
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) return false;
+        struct stat st{};
+        if (fstat(fd_, &st) != 0) return false;
+        created = static_cast<size_t>(st.st_size) != size;
+        if (created && ftruncate(fd_, static_cast<off_t>(size)) != 0) return false;
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) return false;
+        base_ = static_cast<unsigned char*>(p);
+    #endif
+        if (!base_) return false;
+        size_ = size;
+        return true;
+    }
+
+    bool RingFile::open(const std::string& path, const uint32_t slot_count, const uint32_t slot_size) {
+        close();
+        if (slot_count == 0 || slot_size <= sizeof(SlotHeader)) return false;
+
+        slot_count_ = slot_count;
+        slot_size_ = slot_size;
+        bool created = false;
+        if (!map(path, kHeaderSize + static_cast<size_t>(slot_count) * slot_size, created)) {
+            close();
+            return false;
+        }
+
+        auto* hdr = reinterpret_cast<RingHeader*>(base_);
+        const bool valid = !created && std::memcmp(hdr->magic, kMagic, sizeof(kMagic)) == 0 &&
+            hdr->version == kVersion && hdr->slot_count == slot_count && hdr->slot_size == slot_size &&
+            hdr->checksum == header_checksum(*hdr);
+        if (!valid) {
+            // New file or different geometry: start empty
+            std::memset(base_, 0, size_);
+            std::memcpy(hdr->magic, kMagic, sizeof(kMagic));
+            hdr->version = kVersion;
+            hdr->slot_count = slot_count;
+            hdr->slot_size = slot_size;
+            hdr->checksum = header_checksum(*hdr);
+            hdr->write_seq = 1;
+            hdr->clear_seq = 1;
+        }
+        recover();
+        return true;
+    }
+
+    void RingFile::close() {
+    #ifdef _WIN32
+        if (base_) {
+            FlushViewOfFile(base_, 0);
+            UnmapViewOfFile(base_);
+        }
+        if (mapping_) CloseHandle(mapping_);
+        if (file_) CloseHandle(file_);
+        mapping_ = nullptr;
+        file_ = nullptr;
+    #else
+        if (base_) {
+            msync(base_, size_, MS_ASYNC);
+            munmap(base_, size_);
+        }
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = -1;
+    #endif
+        base_ = nullptr;
+        size_ = 0;
+    }
+
+    void RingFile::recover() {
+        const auto* hdr = reinterpret_cast<const RingHeader*>(base_);
+        uint64_t max_seq = 0;
+        for (uint32_t i = 0; i < slot_count_; ++i) {
+            const auto* slot = base_ + kHeaderSize + static_cast<size_t>(i) * slot_size_;
+            const auto* sh = reinterpret_cast<const SlotHeader*>(slot);
+            if (sh->seq == 0 || sh->seq % slot_count_ != i) continue;
+            if (sh->checksum != slot_checksum(slot, slot_size_ - sizeof(SlotHeader))) continue;
+            max_seq = std::max(max_seq, sh->seq);
+        }
+        next_seq_ = std::max({max_seq + 1, hdr->write_seq, hdr->clear_seq});
+    }
+
+    void RingFile::append(const SyslogMessage& msg) {
+        if (!base_) return;
+        const uint64_t seq = next_seq_++;
+        auto* slot = base_ + kHeaderSize + static_cast<size_t>(seq % slot_count_) * slot_size_;
+        auto* sh = reinterpret_cast<SlotHeader*>(slot);
+        const size_t payload = slot_size_ - sizeof(SlotHeader);
+
+        sh->seq = 0; // invalidate while rewriting
+        size_t room = payload;
+        auto clamp = [&room](const std::string& s, const size_t max) {
+            const size_t n = std::min({s.size(), max, room});
+            room -= n;
+            return n;
+        };
+        sh->facility = static_cast<uint8_t>(msg.facility);
+        sh->severity = static_cast<uint8_t>(msg.severity);
+        sh->ts_len = static_cast<uint16_t>(clamp(msg.timestamp, 64));
+        sh->host_len = static_cast<uint16_t>(clamp(msg.hostname, 255));
+        sh->app_len = static_cast<uint16_t>(clamp(msg.app_name, 255));
+        sh->msg_len = static_cast<uint32_t>(clamp(msg.message, payload));
+
+        auto* p = slot + sizeof(SlotHeader);
+        std::memcpy(p, msg.timestamp.data(), sh->ts_len); p += sh->ts_len;
+        std::memcpy(p, msg.hostname.data(), sh->host_len); p += sh->host_len;
+        std::memcpy(p, msg.app_name.data(), sh->app_len); p += sh->app_len;
+        std::memcpy(p, msg.message.data(), sh->msg_len); p += sh->msg_len;
+        std::memset(p, 0, room); // keeps the checksum independent of previous contents
+
+        sh->seq = seq;
+        sh->checksum = slot_checksum(slot, payload);
+        reinterpret_cast<RingHeader*>(base_)->write_seq = next_seq_;
+    }
+
+    void RingFile::clear() {
+        if (!base_) return;
+        reinterpret_cast<RingHeader*>(base_)->clear_seq = next_seq_;
+    }
+
+    std::vector<SyslogMessage> RingFile::load() const {
+        std::vector<SyslogMessage> res;
+        if (!base_) return res;
+
+        const auto* hdr = reinterpret_cast<const RingHeader*>(base_);
+        const uint64_t first = std::max<uint64_t>({hdr->clear_seq, next_seq_ > slot_count_ ? next_seq_ - slot_count_ : 1, 1});
+        const size_t payload = slot_size_ - sizeof(SlotHeader);
+        res.reserve(static_cast<size_t>(next_seq_ - std::min(first, next_seq_)));
+
+        for (uint64_t seq = first; seq < next_seq_; ++seq) {
+            const auto* slot = base_ + kHeaderSize + static_cast<size_t>(seq % slot_count_) * slot_size_;
+            const auto* sh = reinterpret_cast<const SlotHeader*>(slot);
+            if (sh->seq != seq || sh->checksum != slot_checksum(slot, payload)) continue;
+            if (static_cast<size_t>(sh->ts_len) + sh->host_len + sh->app_len + sh->msg_len > payload) continue;
+
+            const auto* p = reinterpret_cast<const char*>(slot + sizeof(SlotHeader));
+            SyslogMessage m;
+            m.facility = static_cast<Facility>(sh->facility);
+            m.severity = static_cast<Severity>(sh->severity & 7);
+            m.timestamp.assign(p, sh->ts_len); p += sh->ts_len;
+            m.hostname.assign(p, sh->host_len); p += sh->host_len;
+            m.app_name.assign(p, sh->app_len); p += sh->app_len;
+            m.message.assign(p, sh->msg_len);
+            res.push_back(std::move(m));
+        }
+        return res;
+    }
+}
@@ -2,9 +2,14 @@
 #include <sstream>
 #include <iomanip>
 #include <ctime>
+#include <charconv>
+#include <algorithm>
+#include <chrono>
 
 namespace SyslogKit {
 
+    static constexpr const char* kMonths[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
     static std::string get_time_rfc3164() {
         std::time_t t = std::time(nullptr);
         std::tm tm_buf{};
@@ -13,29 +18,144 @@ namespace SyslogKit {
         #else
                 localtime_r(&t, &tm_buf);
         #endif
-        const char* months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
         char buffer[32];
         snprintf(buffer, sizeof(buffer), "%s %2d %02d:%02d:%02d",
-                 months[tm_buf.tm_mon], tm_buf.tm_mday,
+                 kMonths[tm_buf.tm_mon], tm_buf.tm_mday,
                  tm_buf.tm_hour, tm_buf.tm_min, tm_buf.tm_sec);
         return {buffer};
     }
 
+    // "Mmm dd hh:mm:ss"
+    static bool is_rfc3164_timestamp(std::string_view s) {
+        auto digit = [](const char c) { return c >= '0' && c <= '9'; };
+        auto alpha = [](const char c) { return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'); };
+        return s.size() >= 15 && alpha(s[0]) && alpha(s[1]) && alpha(s[2]) && s[3] == ' ' &&
+               (s[4] == ' ' || digit(s[4])) && digit(s[5]) && s[6] == ' ' &&
+               digit(s[7]) && digit(s[8]) && s[9] == ':' && digit(s[10]) && digit(s[11]) && s[12] == ':' &&
+               digit(s[13]) && digit(s[14]);
+    }
+
+    // RFC 5424: VERSION SP TIMESTAMP SP HOSTNAME SP APP-NAME SP PROCID SP MSGID SP STRUCTURED-DATA [SP MSG]
+    static void parse_rfc5424(std::string_view raw_msg, size_t pos, SyslogMessage& msg) {
+        auto next_field = [&]() {
+            auto end = raw_msg.find(' ', pos);
+            if (end == std::string_view::npos) end = raw_msg.size();
+            const auto field = raw_msg.substr(pos, end - pos);
+            pos = std::min(end + 1, raw_msg.size());
+            return field == "-" ? std::string() : std::string(field);
+        };
+
+        next_field(); // VERSION
+        msg.timestamp = next_field();
+        msg.hostname = next_field();
+        msg.app_name = next_field();
+        next_field(); // PROCID
+        next_field(); // MSGID
+
+        if (pos < raw_msg.size() && raw_msg[pos] == '-') {
+            pos++;
+        } else {
+            pos += SyslogBuilder::parse_structured_data(raw_msg.substr(pos), msg.structured_data);
+        }
+        if (pos < raw_msg.size() && raw_msg[pos] == ' ') pos++;
+
+        auto text = raw_msg.substr(pos);
+        if (text.starts_with("\xEF\xBB\xBF")) text.remove_prefix(3);
+        msg.message = std::string(text);
+    }
+
+    size_t SyslogBuilder::parse_structured_data(std::string_view text, std::vector<SDElement>& out) {
+        const size_t n = text.size();
+        size_t pos = 0;
+        std::vector<SDElement> parsed;
+
+        auto is_name_char = [](const char c) { return c != ' ' && c != '=' && c != ']' && c != '"'; };
+
+        while (pos < n && text[pos] == '[') {
+            SDElement el;
+            size_t i = pos + 1;
+            while (i < n && is_name_char(text[i])) i++;
+            if (i == pos + 1 || i >= n || (text[i] != ' ' && text[i] != ']')) break;
+            el.id = std::string(text.substr(pos + 1, i - pos - 1));
+
+            bool ok = true;
+            while (ok && i < n && text[i] == ' ') {
+                const size_t name_start = ++i;
+                while (i < n && is_name_char(text[i])) i++;
+                if (i == name_start || i + 1 >= n || text[i] != '=' || text[i + 1] != '"') { ok = false; break; }
+
+                SDParam param;
+                param.name = std::string(text.substr(name_start, i - name_start));
+                i += 2;
+                while (i < n && text[i] != '"') {
+                    if (text[i] == '\\' && i + 1 < n && (text[i + 1] == '"' || text[i + 1] == '\\' || text[i + 1] == ']')) i++;
+                    param.value += text[i++];
+                }
+                if (i >= n) { ok = false; break; }
+                i++; // closing quote
+                el.params.push_back(std::move(param));
+            }
+            if (!ok || i >= n || text[i] != ']') break;
+
+            pos = i + 1;
+            parsed.push_back(std::move(el));
+        }
+
+        if (parsed.empty()) return 0;
+        out.insert(out.end(), std::make_move_iterator(parsed.begin()), std::make_move_iterator(parsed.end()));
+        return pos;
+    }
+
+    std::string SyslogBuilder::format_structured_data(const std::vector<SDElement>& sd) {
+        std::string out;
+        for (const auto& el : sd) {
+            out += '[';
+            out += el.id;
+            for (const auto& [name, value] : el.params) {
+                out += ' ';
+                out += name;
+                out += "=\"";
+                for (const char c : value) {
+                    if (c == '"' || c == '\\' || c == ']') out += '\\';
+                    out += c;
+                }
+                out += '"';
+            }
+            out += ']';
+        }
+        return out;
+    }
+
     std::string SyslogBuilder::build(const SyslogMessage& msg) {
-        std::ostringstream oss;
-        oss << "<" << ((static_cast<int>(msg.facility) * 8) + static_cast<int>(msg.severity)) << ">";
+        std::string out;
+        build_to(msg, out);
+        return out;
+    }
 
-        oss << (msg.timestamp.empty() ? get_time_rfc3164() : msg.timestamp) << " ";
+    void SyslogBuilder::build_to(const SyslogMessage& msg, std::string& out) {
+        char pri[8];
+        const auto [end, ec] = std::to_chars(pri, pri + sizeof(pri), msg.get_priority());
+        out += '<';
+        out.append(pri, end);
+        out += '>';
 
-        oss << (msg.hostname.empty() ? "localhost" : msg.hostname) << " ";
+        out += msg.timestamp.empty() ? get_time_rfc3164() : msg.timestamp;
+        out += ' ';
+
+        out += msg.hostname.empty() ? std::string_view("localhost") : std::string_view(msg.hostname);
+        out += ' ';
 
         if (!msg.app_name.empty()) {
-            oss << msg.app_name << ": ";
+            out += msg.app_name;
+            out += ": ";
         }
 
-        oss << msg.message;
+        if (!msg.structured_data.empty()) {
+            out += format_structured_data(msg.structured_data);
+            if (!msg.message.empty()) out += ' ';
+        }
 
-        return oss.str();
+        out += msg.message;
     }
 
     SyslogMessage SyslogBuilder::parse(std::string_view raw_msg) {
@@ -46,24 +166,73 @@ namespace SyslogKit {
         if (raw_msg[0] == '<') {
             auto end_pri = raw_msg.find('>');
             if (end_pri != std::string_view::npos) {
-                int pri = std::stoi(std::string(raw_msg.substr(1, end_pri - 1)));
-                msg.facility = static_cast<Facility>(pri / 8);
-                msg.severity = static_cast<Severity>(pri % 8);
+                int pri = 0;
+                const auto [ptr, ec] = std::from_chars(raw_msg.data() + 1, raw_msg.data() + end_pri, pri);
+                if (ec == std::errc() && pri >= 0 && pri < 192) {
+                    msg.facility = static_cast<Facility>(pri / 8);
+                    msg.severity = static_cast<Severity>(pri % 8);
+                }
                 pos = end_pri + 1;
             }
         }
-        size_t space_count = 0;
+        if (pos + 1 < raw_msg.size() && raw_msg[pos] >= '1' && raw_msg[pos] <= '9' && raw_msg[pos + 1] == ' ') {
+            parse_rfc5424(raw_msg, pos, msg);
+            return msg;
+        }
+
+        // Timestamp: RFC 3339 ("2026-10-18T12:00:00Z") is one token; RFC 3164 is the fixed-width
+        // "Mmm dd hh:mm:ss" with days 1-9 space-padded ("Oct  1 22:14:15"). Anything else: skip three
+        // tokens, treating runs of spaces as one separator.
+        const auto head = raw_msg.substr(pos, 5);
+        const bool rfc3339 = head.size() == 5 && head[4] == '-' &&
+            std::all_of(head.begin(), head.begin() + 4, [](const char c) { return c >= '0' && c <= '9'; });
+
+        size_t ts_end = std::string_view::npos;
+        if (rfc3339) {
+            ts_end = raw_msg.find(' ', pos);
+        } else if (is_rfc3164_timestamp(raw_msg.substr(pos))) {
+            ts_end = pos + 15;
+        } else {
+            size_t i = pos;
+            for (int token = 0; token < 3 && i < raw_msg.size(); ++token) {
+                while (i < raw_msg.size() && raw_msg[i] == ' ') i++;
+                while (i < raw_msg.size() && raw_msg[i] != ' ') i++;
+            }
+            if (i < raw_msg.size()) ts_end = i;
+        }
+
         size_t last_pos = pos;
-        for (size_t i = pos; i < raw_msg.size() && space_count < 3; ++i) {
-            if (raw_msg[i] == ' ') {
-                space_count++;
-                last_pos = i + 1;
+        if (ts_end != std::string_view::npos && ts_end < raw_msg.size()) {
+            const auto host_start = raw_msg.find_first_not_of(' ', ts_end);
+            const auto next_space = host_start == std::string_view::npos ? host_start : raw_msg.find(' ', host_start);
+            if (next_space != std::string_view::npos) {
+                msg.timestamp = std::string(raw_msg.substr(pos, ts_end - pos));
+                msg.hostname = std::string(raw_msg.substr(host_start, next_space - host_start));
+                last_pos = next_space + 1;
+            } else {
+                last_pos = std::min(ts_end + 1, raw_msg.size());
             }
         }
 
-        const auto next_space = raw_msg.find(' ', last_pos);
-        if (next_space != std::string_view::npos) {
-            last_pos = next_space + 1;
+        // RFC 3164 TAG: "app: " or "app[pid]: "
+        const auto tag_end = raw_msg.find(' ', last_pos);
+        if (tag_end != std::string_view::npos && tag_end > last_pos && raw_msg[tag_end - 1] == ':') {
+            const auto tag = raw_msg.substr(last_pos, tag_end - 1 - last_pos);
+            msg.app_name = std::string(tag.substr(0, tag.find('[')));
+            last_pos = tag_end + 1;
+        }
+
+        // Structured data carried in an RFC 3164 body (as written by build()). Bare "[word]" prefixes
+        // are common in free text, so only elements that carry parameters are taken as SD.
+        if (last_pos < raw_msg.size() && raw_msg[last_pos] == '[') {
+            std::vector<SDElement> sd;
+            const size_t used = parse_structured_data(raw_msg.substr(last_pos), sd);
+            const size_t end = last_pos + used;
+            const bool all_params = std::all_of(sd.begin(), sd.end(), [](const SDElement& el) { return !el.params.empty(); });
+            if (used && all_params && (end == raw_msg.size() || raw_msg[end] == ' ')) {
+                msg.structured_data = std::move(sd);
+                last_pos = std::min(end + 1, raw_msg.size());
+            }
         }
 
         msg.message = std::string(raw_msg.substr(last_pos));
@@ -71,4 +240,96 @@ namespace SyslogKit {
         return msg;
     }
 
+    static bool parse_digits(std::string_view s, const size_t at, const size_t n, int& out) {
+        if (at + n > s.size()) return false;
+        const auto* first = s.data() + at;
+        const auto [ptr, ec] = std::from_chars(first, first + n, out);
+        return ec == std::errc() && ptr == first + n;
+    }
+
+    // "YYYY-MM-DDThh:mm:ss[.frac](Z|+hh:mm|-hh:mm)"; a missing offset is taken as UTC
+    static bool rfc3339_to_epoch_ms(std::string_view ts, int64_t& out) {
+        int y, mo, d, h, mi, sec;
+        if (!parse_digits(ts, 0, 4, y) || ts.size() < 19 || ts[4] != '-' || !parse_digits(ts, 5, 2, mo) ||
+            ts[7] != '-' || !parse_digits(ts, 8, 2, d) || (ts[10] != 'T' && ts[10] != 't') ||
+            !parse_digits(ts, 11, 2, h) || ts[13] != ':' || !parse_digits(ts, 14, 2, mi) || ts[16] != ':' ||
+            !parse_digits(ts, 17, 2, sec)) return false;
+
+        const std::chrono::year_month_day date{std::chrono::year{y}, std::chrono::month(mo), std::chrono::day(d)};
+        if (!date.ok()) return false;
+
+        size_t pos = 19;
+        int64_t ms = 0;
+        if (pos < ts.size() && ts[pos] == '.') {
+            int scale = 100;
+            for (++pos; pos < ts.size() && ts[pos] >= '0' && ts[pos] <= '9'; ++pos, scale /= 10) {
+                ms += (ts[pos] - '0') * scale;
+            }
+        }
+        int offset_min = 0;
+        if (pos < ts.size() && (ts[pos] == '+' || ts[pos] == '-')) {
+            int oh, om;
+            if (!parse_digits(ts, pos + 1, 2, oh) || !parse_digits(ts, pos + 4, 2, om)) return false;
+            offset_min = (ts[pos] == '-' ? -1 : 1) * (oh * 60 + om);
+        }
+
+        const auto days = std::chrono::sys_days(date).time_since_epoch().count();
+        out = ((static_cast<int64_t>(days) * 86400 + h * 3600 + mi * 60 + sec - offset_min * 60) * 1000) + ms;
+        return true;
+    }
+
+    // "Mmm dd hh:mm:ss" in local time. The year is not transmitted: take the current one, or the
+    // previous one if that would put the stamp more than a day in the future (December logs read in January).
+    static bool rfc3164_to_epoch_ms(std::string_view ts, const int64_t now_ms, int64_t& out) {
+        if (!is_rfc3164_timestamp(ts)) return false;
+        const auto month = std::find_if(std::begin(kMonths), std::end(kMonths),
+                                        [&](const char* m) { return ts.substr(0, 3) == m; });
+        if (month == std::end(kMonths)) return false;
+        const int64_t sec_ms = ((ts[13] - '0') * 10 + (ts[14] - '0')) * 1000;
+
+        // localtime/mktime consult the time zone on every call; consecutive lines share the minute
+        thread_local std::string cached_minute;
+        thread_local int64_t cached_hour = -1;
+        thread_local int64_t cached_ms = 0;
+        const auto minute = ts.substr(0, 12);
+        if (cached_hour == now_ms / 3600000 && cached_minute == minute) {
+            out = cached_ms + sec_ms;
+            return true;
+        }
+
+        std::tm tm_buf{};
+        const std::time_t now = static_cast<std::time_t>(now_ms / 1000);
+        #if defined(_WIN32)
+                localtime_s(&tm_buf, &now);
+        #else
+                localtime_r(&now, &tm_buf);
+        #endif
+        const int this_year = tm_buf.tm_year;
+
+        auto to_epoch_ms = [&](const int tm_year) {
+            std::tm tm{};
+            tm.tm_year = tm_year;
+            tm.tm_mon = static_cast<int>(month - std::begin(kMonths));
+            tm.tm_mday = (ts[4] == ' ' ? 0 : (ts[4] - '0') * 10) + (ts[5] - '0');
+            tm.tm_hour = (ts[7] - '0') * 10 + (ts[8] - '0');
+            tm.tm_min = (ts[10] - '0') * 10 + (ts[11] - '0');
+            tm.tm_isdst = -1;
+            return static_cast<int64_t>(std::mktime(&tm)) * 1000;
+        };
+        int64_t ms = to_epoch_ms(this_year);
+        if (ms > now_ms + 86400 * 1000) ms = to_epoch_ms(this_year - 1);
+
+        cached_minute.assign(minute);
+        cached_hour = now_ms / 3600000;
+        cached_ms = ms;
+        out = ms + sec_ms;
+        return true;
+    }
+
+    int64_t SyslogBuilder::timestamp_to_epoch_ms(std::string_view ts, const int64_t now_ms) {
+        int64_t ms;
+        if (rfc3339_to_epoch_ms(ts, ms) || rfc3164_to_epoch_ms(ts, now_ms, ms)) return ms;
+        return now_ms;
+    }
+
 } // namespace syslog
\ No newline at end of file
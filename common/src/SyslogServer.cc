@@ -1,4 +1,5 @@
 #include "SyslogKit/SyslogServer.hxx"
+#include "SyslogKit/Trace.hxx"
 #include <vector>
 #include <iostream>
 
@@ -46,9 +47,15 @@ namespace SyslogKit {
         if (tcp) tcp_thread_ = std::jthread(&Server::tcp_loop, this, port);
     }
 
-    void Server::stop() { running_ = false; }
+    void Server::stop() {
+        running_ = false;
+        // Join so no callback is in flight once stop() returns
+        if (udp_thread_.joinable()) udp_thread_.join();
+        if (tcp_thread_.joinable()) tcp_thread_.join();
+    }
 
     void Server::udp_loop(const uint16_t port) {
+        SYSLOGKIT_TRACE_THREAD("udp");
         const sock_t fd = socket(AF_INET, SOCK_DGRAM, 0);
         if (fd == INVALID_SOCK) return;
 
@@ -70,18 +77,26 @@ namespace SyslogKit {
             fd_set fds; FD_ZERO(&fds); FD_SET(fd, &fds);
             timeval tv{0, 50000};
             if (select(static_cast<int>(fd) + 1, &fds, nullptr, nullptr, &tv) > 0) {
+                SYSLOGKIT_TRACE_SPAN("udp.receive");
                 sockaddr_in cli{};
                 socklen_t len = sizeof(cli);
                 const int n = recvfrom(fd, buf, sizeof(buf), 0, reinterpret_cast<sockaddr *>(&cli), &len);
 
                 if (n > 0) {
-                    auto msg = SyslogBuilder::parse(std::string_view(buf, static_cast<size_t>(n)));
+                    SyslogMessage msg;
+                    {
+                        SYSLOGKIT_TRACE_SPAN("parse");
+                        msg = SyslogBuilder::parse(std::string_view(buf, static_cast<size_t>(n)));
+                    }
                     if(msg.hostname.empty()) {
                         char ip[64];
                         inet_ntop(AF_INET, &cli.sin_addr, ip, 64);
                         msg.hostname = ip;
                     }
-                    if (callback_) callback_(msg);
+                    if (callback_) {
+                        SYSLOGKIT_TRACE_SPAN("callback");
+                        callback_(msg);
+                    }
                 }
             }
         }
@@ -89,6 +104,7 @@ namespace SyslogKit {
     }
 
     void Server::tcp_loop(const uint16_t port) {
+        SYSLOGKIT_TRACE_THREAD("tcp");
         const sock_t fd = socket(AF_INET, SOCK_STREAM, 0);
         if (fd == INVALID_SOCK) return;
 
@@ -108,15 +124,23 @@ namespace SyslogKit {
                 socklen_t len = sizeof(cli);
                 const sock_t client = accept(fd, reinterpret_cast<sockaddr *>(&cli), &len);
                 if (client != INVALID_SOCK) {
+                    SYSLOGKIT_TRACE_SPAN("tcp.receive");
                     char buf[4096];
                     if (const int n = recv(client, buf, sizeof(buf), 0); n > 0) {
-                        auto msg = SyslogBuilder::parse(std::string_view(buf, static_cast<size_t>(n)));
+                        SyslogMessage msg;
+                        {
+                            SYSLOGKIT_TRACE_SPAN("parse");
+                            msg = SyslogBuilder::parse(std::string_view(buf, static_cast<size_t>(n)));
+                        }
                         if(msg.hostname.empty()) {
                             char ip[64];
                             inet_ntop(AF_INET, &cli.sin_addr, ip, 64);
                             msg.hostname = ip;
                         }
-                        if (callback_) callback_(msg);
+                        if (callback_) {
+                            SYSLOGKIT_TRACE_SPAN("callback");
+                            callback_(msg);
+                        }
                     }
                     CLOSE_SOCK(client);
                 }
@@ -0,0 +1,180 @@
+#include "SyslogKit/Trace.hxx"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+namespace SyslogKit {
+
+    namespace {
+
+        constexpr size_t kRingSize = 8192; // events per thread
+
+        struct Event {
+            std::atomic<const char*> name{nullptr};
+            std::atomic<uint64_t> start{0};
+            std::atomic<uint64_t> dur{0};
+            std::atomic<uint32_t> tid{0};
+        };
+
+        struct Ring {
+            std::array<Event, kRingSize> events;
+            std::atomic<uint64_t> head{0};
+        };
+
+        struct Snapshot {
+            const char* name;
+            uint64_t start;
+            uint64_t dur;
+            uint32_t tid;
+        };
+
+        // Rings are never freed: a ring released by an exiting thread is reused by the next one,
+        // so short-lived workers (e.g. import tasks) don't grow memory. Each event keeps its own tid.
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<Ring>> rings;
+            std::vector<Ring*> free_rings;
+            std::map<uint32_t, std::string> thread_names;
+            std::atomic<uint32_t> next_tid{1};
+        };
+
+        Registry& registry() {
+            static Registry r;
+            return r;
+        }
+
+        struct ThreadSlot {
+            Ring* ring = nullptr;
+            uint32_t tid = 0;
+
+            ThreadSlot() {
+                auto& reg = registry();
+                tid = reg.next_tid.fetch_add(1, std::memory_order_relaxed);
+                std::lock_guard lock(reg.mutex);
+                if (!reg.free_rings.empty()) {
+                    ring = reg.free_rings.back();
+                    reg.free_rings.pop_back();
+                } else {
+                    reg.rings.push_back(std::make_unique<Ring>());
+                    ring = reg.rings.back().get();
+                }
+            }
+
+            ~ThreadSlot() {
+                auto& reg = registry();
+                std::lock_guard lock(reg.mutex);
+                reg.free_rings.push_back(ring);
+            }
+        };
+
+        ThreadSlot& thread_slot() {
+            thread_local ThreadSlot slot;
+            return slot;
+        }
+
+        std::vector<Snapshot> snapshot(const Ring& ring) {
+            std::vector<Snapshot> out;
+            const uint64_t head = ring.head.load(std::memory_order_acquire);
+            const uint64_t begin = head > kRingSize ? head - kRingSize : 0;
+            out.reserve(head - begin);
+            for (uint64_t i = begin; i < head; ++i) {
+                const auto& ev = ring.events[i % kRingSize];
+                out.push_back({ev.name.load(std::memory_order_relaxed), ev.start.load(std::memory_order_relaxed),
+                               ev.dur.load(std::memory_order_relaxed), ev.tid.load(std::memory_order_relaxed)});
+            }
+
+            // Entries the writer may have overwritten while we were copying are dropped
+            const uint64_t head_after = ring.head.load(std::memory_order_acquire);
+            const uint64_t valid_from = head_after >= kRingSize ? head_after - kRingSize + 1 : 0;
+            if (valid_from > begin) {
+                out.erase(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(std::min(valid_from - begin, static_cast<uint64_t>(out.size()))));
+            }
+            return out;
+        }
+
+        void append_escaped(std::ostringstream& os, const std::string_view s) {
+            for (const char c : s) {
+                if (c == '"' || c == '\\') os << '\\';
+                if (static_cast<unsigned char>(c) >= 0x20) os << c;
+            }
+        }
+    }
+
+    uint64_t Trace::now_ns() {
+        static const auto epoch = std::chrono::steady_clock::now();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - epoch).count());
+    }
+
+    void Trace::record(const char* name, const uint64_t start_ns, const uint64_t end_ns) {
+        auto& slot = thread_slot();
+        auto& ring = *slot.ring;
+        const uint64_t idx = ring.head.load(std::memory_order_relaxed);
+        auto& ev = ring.events[idx % kRingSize];
+        ev.name.store(name, std::memory_order_relaxed);
+        ev.start.store(start_ns, std::memory_order_relaxed);
+        ev.dur.store(end_ns - start_ns, std::memory_order_relaxed);
+        ev.tid.store(slot.tid, std::memory_order_relaxed);
+        ring.head.store(idx + 1, std::memory_order_release);
+    }
+
+    void Trace::set_thread_name(const char* name) {
+        const uint32_t tid = thread_slot().tid;
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        reg.thread_names[tid] = name;
+    }
+
+    std::string Trace::chrome_trace_json() {
+        auto& reg = registry();
+        std::vector<Snapshot> events;
+        std::map<uint32_t, std::string> names;
+        {
+            std::lock_guard lock(reg.mutex);
+            for (const auto& ring : reg.rings) {
+                auto part = snapshot(*ring);
+                events.insert(events.end(), part.begin(), part.end());
+            }
+            names = reg.thread_names;
+        }
+
+        std::ostringstream os;
+        os.setf(std::ios::fixed);
+        os.precision(3);
+        os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        for (const auto& [tid, name] : names) {
+            os << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+               << ",\"args\":{\"name\":\"";
+            append_escaped(os, name);
+            os << "\"}}";
+            first = false;
+        }
+        for (const auto& ev : events) {
+            if (!ev.name) continue;
+            os << (first ? "" : ",") << "\n{\"name\":\"";
+            append_escaped(os, ev.name);
+            os << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ev.tid
+               << ",\"ts\":" << static_cast<double>(ev.start) / 1000.0
+               << ",\"dur\":" << static_cast<double>(ev.dur) / 1000.0 << "}";
+            first = false;
+        }
+        os << "\n]}\n";
+        return os.str();
+    }
+
+    bool Trace::write_chrome_trace(const std::string& path) {
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        if (!f) return false;
+        f << chrome_trace_json();
+        return static_cast<bool>(f);
+    }
+}